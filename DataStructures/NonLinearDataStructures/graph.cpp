@@ -39,6 +39,1435 @@ Educational Demonstrations:
 #include <algorithm>
 #include <limits>
 #include <iomanip>
+#include <memory>
+#include <string>
+#include <cstdint>
+#include <chrono>
+#include <random>
+#include <stdexcept>
+#include <functional>
+#include <sstream>
+#include <array>
+#include <cmath>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <tuple>
+#include <optional>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+// Fixed set of worker threads for fork-join loops. run() hands the same task
+// to every worker (the calling thread acts as worker 0) and returns once all
+// of them have finished, so each call is also a barrier.
+class ForkJoinPool {
+public:
+    explicit ForkJoinPool(unsigned threads) {
+        for (unsigned id = 1; id < std::max(threads, 1u); ++id) {
+            workers_.emplace_back([this, id] { workerLoop(id); });
+        }
+    }
+    
+    ~ForkJoinPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        start_.notify_all();
+        for (auto& worker : workers_) worker.join();
+    }
+    
+    ForkJoinPool(const ForkJoinPool&) = delete;
+    ForkJoinPool& operator=(const ForkJoinPool&) = delete;
+    
+    unsigned size() const { return static_cast<unsigned>(workers_.size()) + 1; }
+    
+    void run(const std::function<void(unsigned)>& task) {
+        if (workers_.empty()) {
+            task(0);
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            task_ = &task;
+            pending_ = workers_.size();
+            ++generation_;
+        }
+        start_.notify_all();
+        task(0);
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [this] { return pending_ == 0; });
+    }
+    
+    // body(lo, hi, worker) over [begin, end), handed out in chunks of grain
+    // from a shared counter so skewed chunks balance themselves
+    template<typename Body>
+    void parallelFor(size_t begin, size_t end, size_t grain, Body body) {
+        std::atomic<size_t> next{begin};
+        run([&](unsigned worker) {
+            for (;;) {
+                size_t lo = next.fetch_add(grain, std::memory_order_relaxed);
+                if (lo >= end) break;
+                body(lo, std::min(lo + grain, end), worker);
+            }
+        });
+    }
+    
+private:
+    void workerLoop(unsigned id) {
+        uint64_t seen = 0;
+        for (;;) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            start_.wait(lock, [&] { return stopping_ || generation_ != seen; });
+            if (stopping_) return;
+            seen = generation_;
+            const auto* task = task_;
+            lock.unlock();
+            
+            (*task)(id);
+            
+            lock.lock();
+            if (--pending_ == 0) done_.notify_one();
+        }
+    }
+    
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable start_;
+    std::condition_variable done_;
+    const std::function<void(unsigned)>* task_ = nullptr;
+    uint64_t generation_ = 0;
+    size_t pending_ = 0;
+    bool stopping_ = false;
+};
+
+// Index of the lowest set bit; word must be non-zero
+inline unsigned lowestSetBit(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctzll(word));
+#else
+    unsigned bit = 0;
+    while (!(word & 1)) { word >>= 1; ++bit; }
+    return bit;
+#endif
+}
+
+template<typename T> class CsrGraph;
+
+// Min-heap of (key, vertex) that keeps each vertex's slot in position_, so a
+// queued vertex gets decrease-key instead of a duplicate entry and the heap
+// never holds more than V items. With Arity 4 the tree is half as deep as a
+// binary heap and the children of a node sit next to each other in memory.
+template<unsigned Arity>
+class IndexedDaryHeap {
+public:
+    static constexpr uint32_t NOT_IN_HEAP = std::numeric_limits<uint32_t>::max();
+
+    void resize(size_t vertexCount) {
+        entries_.clear();
+        position_.assign(vertexCount, NOT_IN_HEAP);
+    }
+
+    bool empty() const { return entries_.empty(); }
+    size_t size() const { return entries_.size(); }
+    int topKey() const { return entries_.front().key; }
+
+    // Only the queued vertices are touched, so clearing is O(size())
+    void clear() {
+        for (const auto& entry : entries_) position_[entry.vertex] = NOT_IN_HEAP;
+        entries_.clear();
+    }
+
+    // Insert a vertex, or lower its key if it is already queued
+    void pushOrDecrease(uint32_t vertex, int key) {
+        uint32_t at = position_[vertex];
+        if (at == NOT_IN_HEAP) {
+            at = static_cast<uint32_t>(entries_.size());
+            entries_.push_back({key, vertex});
+        } else if (key < entries_[at].key) {
+            entries_[at].key = key;
+        } else {
+            return;
+        }
+        siftUp(at);
+    }
+
+    std::pair<int, uint32_t> popMin() {
+        Entry top = entries_.front();
+        position_[top.vertex] = NOT_IN_HEAP;
+        Entry last = entries_.back();
+        entries_.pop_back();
+        if (!entries_.empty()) {
+            entries_[0] = last;
+            siftDown(0);
+        }
+        return {top.key, top.vertex};
+    }
+
+private:
+    struct Entry {
+        int key;
+        uint32_t vertex;
+    };
+
+    void place(size_t at, const Entry& entry) {
+        entries_[at] = entry;
+        position_[entry.vertex] = static_cast<uint32_t>(at);
+    }
+
+    void siftUp(size_t at) {
+        Entry moving = entries_[at];
+        while (at > 0) {
+            size_t parent = (at - 1) / Arity;
+            if (entries_[parent].key <= moving.key) break;
+            place(at, entries_[parent]);
+            at = parent;
+        }
+        place(at, moving);
+    }
+
+    void siftDown(size_t at) {
+        Entry moving = entries_[at];
+        const size_t count = entries_.size();
+        for (;;) {
+            size_t first = at * Arity + 1;
+            if (first >= count) break;
+            size_t best = first;
+            size_t end = std::min<size_t>(first + Arity, count);
+            for (size_t child = first + 1; child < end; ++child) {
+                if (entries_[child].key < entries_[best].key) best = child;
+            }
+            if (entries_[best].key >= moving.key) break;
+            place(at, entries_[best]);
+            at = best;
+        }
+        place(at, moving);
+    }
+
+    std::vector<Entry> entries_;
+    std::vector<uint32_t> position_; // vertex -> slot in entries_, or NOT_IN_HEAP
+};
+
+// Monotone priority queue for non-negative integer keys (Ahuja, Mehlhorn,
+// Orlin, Tarjan). Bucket b holds keys whose highest bit differing from the
+// last popped key is bit b-1; a pop only redistributes the first non-empty
+// bucket, so each entry moves at most 32 times. Keys pushed must not be
+// smaller than the last key popped, which Dijkstra guarantees. There is no
+// decrease-key: callers skip stale duplicates when they come out.
+class RadixHeap {
+public:
+    bool empty() const { return size_ == 0; }
+
+    void clear() {
+        for (auto& bucket : buckets_) bucket.clear();
+        size_ = 0;
+        last_ = 0;
+    }
+
+    void push(uint32_t key, uint32_t vertex) {
+        buckets_[bucketFor(key)].push_back({key, vertex});
+        ++size_;
+    }
+
+    std::pair<uint32_t, uint32_t> popMin() {
+        if (buckets_[0].empty()) {
+            size_t from = 1;
+            while (buckets_[from].empty()) ++from;
+
+            auto& bucket = buckets_[from];
+            last_ = std::min_element(bucket.begin(), bucket.end(),
+                                     [](const Entry& a, const Entry& b) { return a.key < b.key; })->key;
+            for (const auto& entry : bucket) {
+                buckets_[bucketFor(entry.key)].push_back(entry); // Always a lower bucket
+            }
+            bucket.clear();
+        }
+
+        Entry entry = buckets_[0].back();
+        buckets_[0].pop_back();
+        --size_;
+        return {entry.key, entry.vertex};
+    }
+
+private:
+    struct Entry {
+        uint32_t key;
+        uint32_t vertex;
+    };
+
+    size_t bucketFor(uint32_t key) const {
+        uint32_t diff = key ^ last_;
+        if (diff == 0) return 0;
+#if defined(__GNUC__) || defined(__clang__)
+        return 32 - __builtin_clz(diff);
+#else
+        size_t bits = 0;
+        while (diff) { ++bits; diff >>= 1; }
+        return bits;
+#endif
+    }
+
+    std::array<std::vector<Entry>, 33> buckets_;
+    size_t size_ = 0;
+    uint32_t last_ = 0;
+};
+
+// Per-query state shared by every CsrGraph point-to-point search: plain
+// Dijkstra (shortestPaths), bidirectional Dijkstra and A*/ALT. It holds the
+// forward distances and predecessors, a backward side that is only
+// allocated by the first bidirectional query, and the priority queues.
+// Arrays are sized to the graph once; after that prepare() only resets the
+// vertices the previous query reached, so repeated early-exit queries cost
+// O(explored) and do not allocate.
+class DijkstraWorkspace {
+public:
+    static constexpr uint32_t NO_VERTEX = std::numeric_limits<uint32_t>::max();
+    static constexpr int UNREACHABLE = std::numeric_limits<int>::max();
+
+    enum class Queue { DARY_HEAP, RADIX_HEAP };
+
+    // After a full shortestPaths() run these hold the whole tree. After a
+    // point-to-point query they are final for settled vertices and target.
+    int distance(uint32_t vertex) const { return forward_.distance[vertex]; }
+    uint32_t previous(uint32_t vertex) const { return forward_.previous[vertex]; }
+    const std::vector<uint32_t>& predecessors() const { return forward_.previous; }
+
+    // Vertices popped from the queues by the last query (both directions)
+    size_t settledCount() const { return settled_; }
+
+    // Vertices from the source to target along the predecessor array, or
+    // empty if the last query did not reach target
+    std::vector<uint32_t> pathTo(uint32_t target) const {
+        std::vector<uint32_t> path;
+        if (forward_.distance[target] == UNREACHABLE) return path;
+        for (uint32_t v = target; v != NO_VERTEX; v = forward_.previous[v]) {
+            path.push_back(v);
+        }
+        std::reverse(path.begin(), path.end());
+        return path;
+    }
+
+private:
+    template<typename> friend class CsrGraph;
+
+    // One search direction. For the backward side "previous" is the next
+    // vertex towards the target.
+    struct Side {
+        std::vector<int> distance;
+        std::vector<uint32_t> previous;
+        std::vector<uint32_t> touched;
+        IndexedDaryHeap<4> heap;
+
+        void prepare(size_t vertexCount) {
+            if (distance.size() != vertexCount) {
+                distance.assign(vertexCount, UNREACHABLE);
+                previous.assign(vertexCount, NO_VERTEX);
+                heap.resize(vertexCount);
+                touched.clear();
+            } else {
+                for (uint32_t v : touched) {
+                    distance[v] = UNREACHABLE;
+                    previous[v] = NO_VERTEX;
+                }
+                touched.clear();
+                heap.clear();
+            }
+        }
+
+        void assign(uint32_t vertex, int newDist, uint32_t from) {
+            if (distance[vertex] == UNREACHABLE) touched.push_back(vertex);
+            distance[vertex] = newDist;
+            previous[vertex] = from;
+        }
+
+        // Record a shorter distance; false if newDist does not improve on it
+        bool relax(uint32_t vertex, int newDist, uint32_t from) {
+            if (newDist >= distance[vertex]) return false;
+            assign(vertex, newDist, from);
+            return true;
+        }
+    };
+
+    void prepare(size_t vertexCount, bool bidirectional = false) {
+        forward_.prepare(vertexCount);
+        if (bidirectional) backward_.prepare(vertexCount);
+        radix_.clear();
+        settled_ = 0;
+    }
+
+    Side forward_;
+    Side backward_;
+    RadixHeap radix_;
+    size_t settled_ = 0;
+};
+
+// Read-only Compressed Sparse Row snapshot of a graph, built by Graph::freeze().
+// Vertices are renumbered to dense ids 0..V-1 (in adjacency-map order) and the
+// out-edges of v are targets_/weights_[offsets_[v] .. offsets_[v+1]), so a
+// traversal walks contiguous arrays instead of hash buckets and list nodes.
+// Algorithms here work on dense ids; Graph translates labels at the boundary.
+template<typename T>
+class CsrGraph {
+public:
+    using VertexId = uint32_t;
+    static constexpr VertexId NO_VERTEX = std::numeric_limits<VertexId>::max();
+    static constexpr size_t NO_EDGE = std::numeric_limits<size_t>::max();
+    static constexpr int UNREACHABLE = std::numeric_limits<int>::max();
+
+    // Build from any map of label -> container of {destination, weight} edges
+    template<typename AdjacencyMap>
+    explicit CsrGraph(const AdjacencyMap& adjacency) {
+        if (adjacency.size() >= NO_VERTEX) {
+            throw std::length_error("CsrGraph: too many vertices for 32-bit ids");
+        }
+
+        size_t edges = 0;
+        labels_.reserve(adjacency.size());
+        ids_.reserve(adjacency.size());
+        for (const auto& [vertex, list] : adjacency) {
+            ids_.emplace(vertex, static_cast<VertexId>(labels_.size()));
+            labels_.push_back(vertex);
+            edges += list.size();
+        }
+
+        offsets_.reserve(labels_.size() + 1);
+        targets_.reserve(edges);
+        weights_.reserve(edges);
+        for (const auto& [vertex, list] : adjacency) {
+            offsets_.push_back(targets_.size());
+            for (const auto& edge : list) {
+                targets_.push_back(ids_.at(edge.destination));
+                weights_.push_back(edge.weight);
+            }
+        }
+        offsets_.push_back(targets_.size());
+    }
+
+    struct WeightedEdge {
+        VertexId from;
+        VertexId to;
+        int weight;
+    };
+    
+    // Labels 0..vertexCount-1 built straight from an edge list (counting sort
+    // on the source), for generated graphs too large to load through Graph.
+    // With symmetric set every edge is stored in both directions.
+    static CsrGraph fromEdgeList(size_t vertexCount, const std::vector<WeightedEdge>& edges, bool symmetric) {
+        CsrGraph graph;
+        graph.labels_.reserve(vertexCount);
+        graph.ids_.reserve(vertexCount);
+        for (size_t v = 0; v < vertexCount; ++v) {
+            graph.labels_.push_back(static_cast<T>(v));
+            graph.ids_.emplace(static_cast<T>(v), static_cast<VertexId>(v));
+        }
+        
+        graph.offsets_.assign(vertexCount + 1, 0);
+        for (const auto& edge : edges) {
+            ++graph.offsets_[edge.from + 1];
+            if (symmetric) ++graph.offsets_[edge.to + 1];
+        }
+        for (size_t v = 0; v < vertexCount; ++v) {
+            graph.offsets_[v + 1] += graph.offsets_[v];
+        }
+        
+        std::vector<size_t> cursor(graph.offsets_.begin(), graph.offsets_.end() - 1);
+        graph.targets_.resize(graph.offsets_.back());
+        graph.weights_.resize(graph.offsets_.back());
+        for (const auto& edge : edges) {
+            size_t slot = cursor[edge.from]++;
+            graph.targets_[slot] = edge.to;
+            graph.weights_[slot] = edge.weight;
+            if (symmetric) {
+                slot = cursor[edge.to]++;
+                graph.targets_[slot] = edge.from;
+                graph.weights_[slot] = edge.weight;
+            }
+        }
+        return graph;
+    }
+    
+    // Same vertices and ids with every edge reversed; gives directed graphs
+    // the incoming-edge lists that bottom-up BFS needs
+    CsrGraph transpose() const {
+        CsrGraph reversed;
+        reversed.labels_ = labels_;
+        reversed.ids_ = ids_;
+        reversed.offsets_.assign(vertexCount() + 1, 0);
+        for (VertexId t : targets_) ++reversed.offsets_[t + 1];
+        for (size_t v = 0; v < vertexCount(); ++v) {
+            reversed.offsets_[v + 1] += reversed.offsets_[v];
+        }
+        
+        std::vector<size_t> cursor(reversed.offsets_.begin(), reversed.offsets_.end() - 1);
+        reversed.targets_.resize(targets_.size());
+        reversed.weights_.resize(weights_.size());
+        for (VertexId v = 0; v < vertexCount(); ++v) {
+            for (size_t e = offsets_[v]; e < offsets_[v + 1]; ++e) {
+                size_t slot = cursor[targets_[e]]++;
+                reversed.targets_[slot] = v;
+                reversed.weights_[slot] = weights_[e];
+            }
+        }
+        return reversed;
+    }
+    
+    size_t vertexCount() const { return labels_.size(); }
+    size_t edgeCount() const { return targets_.size(); }
+    size_t degree(VertexId vertex) const { return offsets_[vertex + 1] - offsets_[vertex]; }
+
+    // Dense id of a label, or NO_VERTEX
+    VertexId idOf(const T& label) const {
+        auto it = ids_.find(label);
+        return it == ids_.end() ? NO_VERTEX : it->second;
+    }
+
+    const T& labelOf(VertexId vertex) const { return labels_[vertex]; }
+
+    // Out-edges of a vertex are the edge indices [edgesBegin, edgesEnd)
+    size_t edgesBegin(VertexId vertex) const { return offsets_[vertex]; }
+    size_t edgesEnd(VertexId vertex) const { return offsets_[vertex + 1]; }
+    VertexId target(size_t edge) const { return targets_[edge]; }
+    int weight(size_t edge) const { return weights_[edge]; }
+
+    // Breadth-first order from source; the result vector doubles as the queue
+    std::vector<VertexId> bfs(VertexId source) const {
+        std::vector<VertexId> order;
+        std::vector<uint8_t> visited(vertexCount(), 0);
+
+        order.push_back(source);
+        visited[source] = 1;
+        for (size_t head = 0; head < order.size(); ++head) {
+            VertexId current = order[head];
+            for (size_t e = offsets_[current]; e < offsets_[current + 1]; ++e) {
+                VertexId next = targets_[e];
+                if (!visited[next]) {
+                    visited[next] = 1;
+                    order.push_back(next);
+                }
+            }
+        }
+        return order;
+    }
+
+    struct BfsTree {
+        std::vector<int32_t> level;    // -1 for unreached vertices
+        std::vector<VertexId> parent;  // NO_VERTEX if unreached; the source is its own parent
+        size_t reached = 0;
+        size_t topDownSteps = 0;
+        size_t bottomUpSteps = 0;
+    };
+    
+    // Beamer's switching thresholds: go bottom-up once the frontier's edges
+    // exceed unexplored edges / alpha, return top-down once the frontier
+    // shrinks below V / beta
+    struct BfsOptions {
+        double alpha = 14.0;
+        double beta = 24.0;
+        bool directionOptimizing = true;
+    };
+    
+    // Direction-optimizing BFS (Beamer, Asanovic, Patterson) on a fork-join
+    // pool. Top-down steps expand a vertex queue and claim targets with an
+    // atomic fetch_or on the visited bitmap. Bottom-up steps let every
+    // unvisited vertex look for any parent in the frontier bitmap; workers own
+    // whole 64-vertex words there, so those steps need no atomics at all.
+    // Bottom-up reads incoming edges: pass the transpose for a directed graph,
+    // or nullptr when the graph is symmetric (undirected).
+    BfsTree parallelBfs(VertexId source, ForkJoinPool& pool, const CsrGraph* incoming = nullptr,
+                        const BfsOptions& options = BfsOptions()) const {
+        const CsrGraph& in = incoming ? *incoming : *this;
+        const size_t n = vertexCount();
+        const size_t words = (n + 63) / 64;
+        const unsigned threads = pool.size();
+        
+        BfsTree tree;
+        tree.level.assign(n, -1);
+        tree.parent.assign(n, NO_VERTEX);
+        if (source >= n) return tree;
+        
+        std::vector<std::atomic<uint64_t>> visited(words);
+        std::vector<uint64_t> frontierBits(words, 0);
+        std::vector<uint64_t> nextBits(words, 0);
+        std::vector<VertexId> frontier{source};
+        std::vector<std::vector<VertexId>> localNext(threads);
+        std::vector<size_t> localFound(threads);
+        std::vector<size_t> localEdges(threads);
+        
+        visited[source / 64].store(uint64_t(1) << (source % 64), std::memory_order_relaxed);
+        tree.level[source] = 0;
+        tree.parent[source] = source;
+        tree.reached = 1;
+        
+        size_t frontierSize = 1;
+        size_t frontierEdges = degree(source);
+        size_t unexploredEdges = edgeCount() - frontierEdges;
+        bool bottomUp = false;
+        
+        auto gatherQueue = [&]() {
+            frontier.clear();
+            for (auto& local : localNext) {
+                frontier.insert(frontier.end(), local.begin(), local.end());
+                local.clear();
+            }
+        };
+        
+        for (int32_t depth = 0; frontierSize > 0; ++depth) {
+            if (options.directionOptimizing && !bottomUp &&
+                static_cast<double>(frontierEdges) > unexploredEdges / options.alpha) {
+                std::fill(frontierBits.begin(), frontierBits.end(), 0);
+                for (VertexId v : frontier) frontierBits[v / 64] |= uint64_t(1) << (v % 64);
+                bottomUp = true;
+            } else if (bottomUp && static_cast<double>(frontierSize) < n / options.beta) {
+                pool.parallelFor(0, words, 256, [&](size_t lo, size_t hi, unsigned worker) {
+                    for (size_t w = lo; w < hi; ++w) {
+                        for (uint64_t bits = frontierBits[w]; bits; bits &= bits - 1) {
+                            localNext[worker].push_back(static_cast<VertexId>(w * 64 + lowestSetBit(bits)));
+                        }
+                    }
+                });
+                gatherQueue();
+                bottomUp = false;
+            }
+            
+            std::fill(localFound.begin(), localFound.end(), 0);
+            std::fill(localEdges.begin(), localEdges.end(), 0);
+            
+            if (bottomUp) {
+                ++tree.bottomUpSteps;
+                pool.parallelFor(0, words, 64, [&](size_t lo, size_t hi, unsigned worker) {
+                    size_t found = 0;
+                    size_t edges = 0;
+                    for (size_t w = lo; w < hi; ++w) {
+                        uint64_t candidates = ~visited[w].load(std::memory_order_relaxed);
+                        if (w == words - 1 && n % 64) candidates &= (uint64_t(1) << (n % 64)) - 1;
+                        uint64_t discovered = 0;
+                        for (; candidates; candidates &= candidates - 1) {
+                            unsigned bit = lowestSetBit(candidates);
+                            VertexId v = static_cast<VertexId>(w * 64 + bit);
+                            for (size_t e = in.offsets_[v]; e < in.offsets_[v + 1]; ++e) {
+                                VertexId u = in.targets_[e];
+                                if (frontierBits[u / 64] & (uint64_t(1) << (u % 64))) {
+                                    tree.parent[v] = u;
+                                    tree.level[v] = depth + 1;
+                                    discovered |= uint64_t(1) << bit;
+                                    ++found;
+                                    edges += degree(v);
+                                    break;
+                                }
+                            }
+                        }
+                        nextBits[w] = discovered;
+                        if (discovered) visited[w].fetch_or(discovered, std::memory_order_relaxed);
+                    }
+                    localFound[worker] += found;
+                    localEdges[worker] += edges;
+                });
+                std::swap(frontierBits, nextBits);
+            } else {
+                ++tree.topDownSteps;
+                pool.parallelFor(0, frontier.size(), 64, [&](size_t lo, size_t hi, unsigned worker) {
+                    auto& out = localNext[worker];
+                    size_t edges = 0;
+                    for (size_t i = lo; i < hi; ++i) {
+                        VertexId u = frontier[i];
+                        for (size_t e = offsets_[u]; e < offsets_[u + 1]; ++e) {
+                            VertexId v = targets_[e];
+                            uint64_t bit = uint64_t(1) << (v % 64);
+                            auto& word = visited[v / 64];
+                            if (word.load(std::memory_order_relaxed) & bit) continue;
+                            if (word.fetch_or(bit, std::memory_order_relaxed) & bit) continue;
+                            tree.parent[v] = u;
+                            tree.level[v] = depth + 1;
+                            out.push_back(v);
+                            edges += degree(v);
+                        }
+                    }
+                    localEdges[worker] += edges;
+                });
+                for (unsigned t = 0; t < threads; ++t) localFound[t] = localNext[t].size();
+                gatherQueue();
+            }
+            
+            frontierSize = 0;
+            frontierEdges = 0;
+            for (unsigned t = 0; t < threads; ++t) {
+                frontierSize += localFound[t];
+                frontierEdges += localEdges[t];
+            }
+            unexploredEdges -= std::min(unexploredEdges, frontierEdges);
+            tree.reached += frontierSize;
+        }
+        return tree;
+    }
+    
+    // Same visiting order as Graph::DFS (stack, neighbors pushed in reverse)
+    std::vector<VertexId> dfs(VertexId source) const {
+        std::vector<VertexId> order;
+        std::vector<VertexId> stack{source};
+        std::vector<uint8_t> visited(vertexCount(), 0);
+
+        while (!stack.empty()) {
+            VertexId current = stack.back();
+            stack.pop_back();
+            if (visited[current]) continue;
+
+            visited[current] = 1;
+            order.push_back(current);
+            for (size_t e = offsets_[current + 1]; e-- > offsets_[current];) {
+                if (!visited[targets_[e]]) {
+                    stack.push_back(targets_[e]);
+                }
+            }
+        }
+        return order;
+    }
+
+    // Same preorder as Graph::DFSRecursive, driven by an explicit stack of
+    // (vertex, next edge) so long paths cannot overflow the call stack
+    std::vector<VertexId> dfsPreorder(VertexId source) const {
+        std::vector<VertexId> order;
+        std::vector<std::pair<VertexId, size_t>> stack;
+        std::vector<uint8_t> visited(vertexCount(), 0);
+
+        visited[source] = 1;
+        order.push_back(source);
+        stack.emplace_back(source, offsets_[source]);
+        while (!stack.empty()) {
+            auto& [vertex, edge] = stack.back();
+            if (edge == offsets_[vertex + 1]) {
+                stack.pop_back();
+                continue;
+            }
+            VertexId next = targets_[edge++];
+            if (!visited[next]) {
+                visited[next] = 1;
+                order.push_back(next);
+                stack.emplace_back(next, offsets_[next]);
+            }
+        }
+        return order;
+    }
+
+    // One-shot Dijkstra on std::priority_queue with lazy deletion; allocates
+    // its arrays per call. Stops as soon as target is settled when one is
+    // given; previous, if non-null, receives the shortest-path tree
+    // (NO_VERTEX for the source and unreached vertices).
+    std::vector<int> dijkstra(VertexId source, VertexId target = NO_VERTEX,
+                              std::vector<VertexId>* previous = nullptr) const {
+        using Entry = std::pair<int, VertexId>;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+        std::vector<int> distance(vertexCount(), UNREACHABLE);
+        if (previous) previous->assign(vertexCount(), NO_VERTEX);
+
+        distance[source] = 0;
+        heap.emplace(0, source);
+        while (!heap.empty()) {
+            auto [dist, current] = heap.top();
+            heap.pop();
+            if (dist > distance[current]) continue; // Stale entry
+            if (current == target) break;
+
+            for (size_t e = offsets_[current]; e < offsets_[current + 1]; ++e) {
+                VertexId next = targets_[e];
+                int newDist = dist + weights_[e];
+                if (newDist < distance[next]) {
+                    distance[next] = newDist;
+                    if (previous) (*previous)[next] = current;
+                    heap.emplace(newDist, next);
+                }
+            }
+        }
+        return distance;
+    }
+
+    // Dijkstra into a reusable workspace. With a target it stops as soon as
+    // that vertex is settled; otherwise it computes the whole tree. Results
+    // are read back through workspace.distance()/previous()/pathTo().
+    // RADIX_HEAP needs non-negative weights whose path sums fit in 32 bits.
+    void shortestPaths(VertexId source, VertexId target, DijkstraWorkspace& workspace,
+                       DijkstraWorkspace::Queue queue = DijkstraWorkspace::Queue::DARY_HEAP) const {
+        workspace.prepare(vertexCount());
+        workspace.forward_.relax(source, 0, NO_VERTEX);
+        if (queue == DijkstraWorkspace::Queue::RADIX_HEAP) {
+            runRadixDijkstra(source, target, workspace);
+        } else {
+            runHeapDijkstra(source, target, workspace);
+        }
+    }
+
+    // Bidirectional Dijkstra: a forward search from source and a backward
+    // search from target over incoming edges (pass the transpose for a
+    // directed graph, nullptr when the graph is symmetric). Each step expands
+    // the side with the smaller queue. The search stops once the two queue
+    // minima add up to at least the best meeting distance. The backward half
+    // of the path is then copied into the forward arrays, so
+    // workspace.distance(target) and pathTo(target) read as for shortestPaths().
+    void bidirectionalShortestPath(VertexId source, VertexId target, DijkstraWorkspace& workspace,
+                                   const CsrGraph* incoming = nullptr) const {
+        const CsrGraph& in = incoming ? *incoming : *this;
+        workspace.prepare(vertexCount(), true);
+        auto& forward = workspace.forward_;
+        auto& backward = workspace.backward_;
+        
+        forward.relax(source, 0, NO_VERTEX);
+        forward.heap.pushOrDecrease(source, 0);
+        backward.relax(target, 0, NO_VERTEX);
+        backward.heap.pushOrDecrease(target, 0);
+        int64_t best = source == target ? 0 : std::numeric_limits<int64_t>::max();
+        VertexId meeting = source == target ? source : NO_VERTEX;
+        
+        while (!forward.heap.empty() && !backward.heap.empty()) {
+            if (int64_t(forward.heap.topKey()) + backward.heap.topKey() >= best) break;
+            
+            bool forwardStep = forward.heap.size() <= backward.heap.size();
+            auto& side = forwardStep ? forward : backward;
+            auto& other = forwardStep ? backward : forward;
+            const CsrGraph& graph = forwardStep ? *this : in;
+            
+            auto [dist, current] = side.heap.popMin();
+            ++workspace.settled_;
+            for (size_t e = graph.offsets_[current]; e < graph.offsets_[current + 1]; ++e) {
+                VertexId next = graph.targets_[e];
+                int newDist = dist + graph.weights_[e];
+                if (!side.relax(next, newDist, current)) continue;
+                side.heap.pushOrDecrease(next, newDist);
+                if (other.distance[next] != UNREACHABLE && int64_t(newDist) + other.distance[next] < best) {
+                    best = int64_t(newDist) + other.distance[next];
+                    meeting = next;
+                }
+            }
+        }
+        
+        if (meeting == NO_VERTEX) return;
+        for (VertexId v = meeting; backward.previous[v] != NO_VERTEX; v = backward.previous[v]) {
+            VertexId next = backward.previous[v];
+            forward.assign(next, forward.distance[v] + (backward.distance[v] - backward.distance[next]), v);
+        }
+    }
+    
+    // A* from source to target. heuristic(v) must never overestimate the
+    // distance from v to target. With a consistent heuristic (e.g. ALT) every
+    // vertex is settled once; an admissible but inconsistent one still gives
+    // exact distances because improved vertices re-enter the heap.
+    template<typename Heuristic>
+    void aStar(VertexId source, VertexId target, DijkstraWorkspace& workspace, Heuristic heuristic) const {
+        workspace.prepare(vertexCount());
+        auto& side = workspace.forward_;
+        side.relax(source, 0, NO_VERTEX);
+        side.heap.pushOrDecrease(source, heuristic(source));
+        
+        while (!side.heap.empty()) {
+            VertexId current = side.heap.popMin().second;
+            ++workspace.settled_;
+            if (current == target) break;
+            
+            int dist = side.distance[current];
+            for (size_t e = offsets_[current]; e < offsets_[current + 1]; ++e) {
+                VertexId next = targets_[e];
+                int newDist = dist + weights_[e];
+                if (side.relax(next, newDist, current)) {
+                    side.heap.pushOrDecrease(next, newDist + heuristic(next));
+                }
+            }
+        }
+    }
+    
+    struct SpanningForest {
+        std::vector<WeightedEdge> edges;
+        std::vector<VertexId> component; // Smallest vertex id in each tree
+        int64_t totalWeight = 0;
+        size_t rounds = 0;
+    };
+    
+    // Parallel Boruvka minimum spanning forest for an undirected (symmetric)
+    // snapshot. Every round each vertex scans its still-external edges for the
+    // lightest one, swapping edges that have become internal out of its active
+    // range for good, and the lightest edge per component is picked with a
+    // CAS-min keyed on (weight, lower endpoint, higher endpoint). That total
+    // order makes the picked edges a forest, so hooking them with the
+    // lock-free link() adds each exactly once.
+    SpanningForest minimumSpanningForest(ForkJoinPool& pool) const {
+        const size_t n = vertexCount();
+        SpanningForest forest;
+        std::vector<std::atomic<VertexId>> component(n);
+        std::vector<std::atomic<VertexId>> cheapest(n);
+        pool.parallelFor(0, n, 4096, [&](size_t lo, size_t hi, unsigned) {
+            for (size_t v = lo; v < hi; ++v) {
+                component[v].store(static_cast<VertexId>(v), std::memory_order_relaxed);
+                cheapest[v].store(NO_VERTEX, std::memory_order_relaxed);
+            }
+        });
+        
+        // Working copy of the adjacency; [offsets_[v], activeEnd[v]) are the
+        // edges of v not yet known to be internal
+        std::vector<VertexId> active(targets_);
+        std::vector<int> activeWeight(weights_);
+        std::vector<size_t> activeEnd(offsets_.begin() + 1, offsets_.end());
+        std::vector<size_t> best(n);
+        
+        // Strict order on a vertex's best edge; ties on weight fall back to
+        // the endpoint pair, which both directions of an edge share
+        auto key = [&](VertexId v) {
+            VertexId to = active[best[v]];
+            return std::make_tuple(activeWeight[best[v]], std::min(v, to), std::max(v, to));
+        };
+        
+        std::vector<std::vector<WeightedEdge>> localEdges(pool.size());
+        for (;;) {
+            ++forest.rounds;
+            // Each vertex's best edge is settled in its own pass: the CAS-min
+            // below compares other vertices' picks
+            pool.parallelFor(0, n, 1024, [&](size_t lo, size_t hi, unsigned) {
+                for (size_t i = lo; i < hi; ++i) {
+                    VertexId v = static_cast<VertexId>(i);
+                    VertexId root = component[v].load(std::memory_order_relaxed);
+                    size_t chosen = NO_EDGE;
+                    size_t& end = activeEnd[v];
+                    for (size_t e = offsets_[v]; e < end;) {
+                        VertexId to = active[e];
+                        if (component[to].load(std::memory_order_relaxed) == root) {
+                            --end;
+                            std::swap(active[e], active[end]);
+                            std::swap(activeWeight[e], activeWeight[end]);
+                            continue;
+                        }
+                        if (chosen == NO_EDGE || activeWeight[e] < activeWeight[chosen] ||
+                            (activeWeight[e] == activeWeight[chosen] && to < active[chosen])) {
+                            chosen = e;
+                        }
+                        ++e;
+                    }
+                    best[v] = chosen;
+                }
+            });
+            pool.parallelFor(0, n, 1024, [&](size_t lo, size_t hi, unsigned) {
+                for (size_t i = lo; i < hi; ++i) {
+                    VertexId v = static_cast<VertexId>(i);
+                    if (best[v] == NO_EDGE) continue;
+                    VertexId root = component[v].load(std::memory_order_relaxed);
+                    auto mine = key(v);
+                    VertexId current = cheapest[root].load(std::memory_order_relaxed);
+                    while (current == NO_VERTEX || mine < key(current)) {
+                        if (cheapest[root].compare_exchange_weak(current, v, std::memory_order_relaxed)) break;
+                    }
+                }
+            });
+            
+            std::atomic<size_t> hooked{0};
+            pool.parallelFor(0, n, 1024, [&](size_t lo, size_t hi, unsigned worker) {
+                size_t added = 0;
+                for (size_t r = lo; r < hi; ++r) {
+                    VertexId v = cheapest[r].load(std::memory_order_relaxed);
+                    if (v == NO_VERTEX) continue;
+                    cheapest[r].store(NO_VERTEX, std::memory_order_relaxed);
+                    VertexId to = active[best[v]];
+                    if (link(component, v, to)) {
+                        localEdges[worker].push_back({v, to, activeWeight[best[v]]});
+                        ++added;
+                    }
+                }
+                hooked.fetch_add(added, std::memory_order_relaxed);
+            });
+            compress(component, pool);
+            if (hooked.load() == 0) break;
+        }
+        
+        for (auto& local : localEdges) {
+            for (const auto& edge : local) forest.totalWeight += edge.weight;
+            forest.edges.insert(forest.edges.end(), local.begin(), local.end());
+        }
+        forest.component.resize(n);
+        for (size_t v = 0; v < n; ++v) forest.component[v] = component[v].load(std::memory_order_relaxed);
+        return forest;
+    }
+    
+    // Connected components with a lock-free union-find in the style of
+    // Afforest (Sutton, Ben-Nun, Barak): link along the first two edges of
+    // every vertex, find the largest component from a sample, then link the
+    // remaining edges of vertices outside it only. Returns, per vertex, the
+    // smallest vertex id of its component. For a directed graph pass the
+    // transpose to get weakly connected components.
+    std::vector<VertexId> connectedComponents(ForkJoinPool& pool, const CsrGraph* incoming = nullptr) const {
+        const size_t n = vertexCount();
+        const size_t NEIGHBOR_ROUNDS = 2;
+        std::vector<std::atomic<VertexId>> component(n);
+        pool.parallelFor(0, n, 4096, [&](size_t lo, size_t hi, unsigned) {
+            for (size_t v = lo; v < hi; ++v) component[v].store(static_cast<VertexId>(v), std::memory_order_relaxed);
+        });
+        
+        for (size_t round = 0; round < NEIGHBOR_ROUNDS; ++round) {
+            pool.parallelFor(0, n, 4096, [&](size_t lo, size_t hi, unsigned) {
+                for (size_t v = lo; v < hi; ++v) {
+                    if (round < degree(static_cast<VertexId>(v))) {
+                        link(component, static_cast<VertexId>(v), targets_[offsets_[v] + round]);
+                    }
+                }
+            });
+            compress(component, pool);
+        }
+        
+        VertexId giant = NO_VERTEX;
+        if (n > 0) {
+            std::unordered_map<VertexId, size_t> samples;
+            std::mt19937 rng(n);
+            size_t best = 0;
+            for (int i = 0; i < 1024; ++i) {
+                VertexId root = component[rng() % n].load(std::memory_order_relaxed);
+                if (++samples[root] > best) {
+                    best = samples[root];
+                    giant = root;
+                }
+            }
+        }
+        
+        pool.parallelFor(0, n, 1024, [&](size_t lo, size_t hi, unsigned) {
+            for (size_t i = lo; i < hi; ++i) {
+                VertexId v = static_cast<VertexId>(i);
+                if (component[v].load(std::memory_order_relaxed) == giant) continue;
+                for (size_t e = offsets_[v] + std::min(NEIGHBOR_ROUNDS, degree(v)); e < offsets_[v + 1]; ++e) {
+                    link(component, v, targets_[e]);
+                }
+                if (incoming) {
+                    for (size_t e = incoming->offsets_[v]; e < incoming->offsets_[v + 1]; ++e) {
+                        link(component, v, incoming->targets_[e]);
+                    }
+                }
+            }
+        });
+        compress(component, pool);
+        
+        std::vector<VertexId> ids(n);
+        for (size_t v = 0; v < n; ++v) ids[v] = component[v].load(std::memory_order_relaxed);
+        return ids;
+    }
+    
+    // Three-colour iterative DFS; a grey target is a back edge
+    bool hasCycle() const {
+        enum : uint8_t { WHITE, GREY, BLACK };
+        std::vector<uint8_t> color(vertexCount(), WHITE);
+        std::vector<std::pair<VertexId, size_t>> stack;
+
+        for (VertexId root = 0; root < vertexCount(); ++root) {
+            if (color[root] != WHITE) continue;
+            color[root] = GREY;
+            stack.emplace_back(root, offsets_[root]);
+            while (!stack.empty()) {
+                auto& [vertex, edge] = stack.back();
+                if (edge == offsets_[vertex + 1]) {
+                    color[vertex] = BLACK;
+                    stack.pop_back();
+                    continue;
+                }
+                VertexId next = targets_[edge++];
+                if (color[next] == GREY) return true;
+                if (color[next] == WHITE) {
+                    color[next] = GREY;
+                    stack.emplace_back(next, offsets_[next]);
+                }
+            }
+        }
+        return false;
+    }
+
+    // Kahn's algorithm; an order shorter than vertexCount() means a cycle
+    std::vector<VertexId> topologicalOrder() const {
+        std::vector<uint32_t> inDegree(vertexCount(), 0);
+        for (VertexId t : targets_) ++inDegree[t];
+
+        std::vector<VertexId> order;
+        order.reserve(vertexCount());
+        for (VertexId v = 0; v < vertexCount(); ++v) {
+            if (inDegree[v] == 0) order.push_back(v);
+        }
+        for (size_t head = 0; head < order.size(); ++head) {
+            VertexId current = order[head];
+            for (size_t e = offsets_[current]; e < offsets_[current + 1]; ++e) {
+                if (--inDegree[targets_[e]] == 0) order.push_back(targets_[e]);
+            }
+        }
+        return order;
+    }
+
+private:
+    void runHeapDijkstra(VertexId source, VertexId target, DijkstraWorkspace& workspace) const {
+        auto& side = workspace.forward_;
+        auto& heap = side.heap;
+        heap.pushOrDecrease(source, 0);
+        while (!heap.empty()) {
+            auto [dist, current] = heap.popMin();
+            ++workspace.settled_;
+            if (current == target) break;
+
+            for (size_t e = offsets_[current]; e < offsets_[current + 1]; ++e) {
+                int newDist = dist + weights_[e];
+                if (side.relax(targets_[e], newDist, current)) {
+                    heap.pushOrDecrease(targets_[e], newDist);
+                }
+            }
+        }
+    }
+
+    void runRadixDijkstra(VertexId source, VertexId target, DijkstraWorkspace& workspace) const {
+        auto& side = workspace.forward_;
+        auto& radix = workspace.radix_;
+        radix.push(0, source);
+        while (!radix.empty()) {
+            auto [key, current] = radix.popMin();
+            int dist = static_cast<int>(key);
+            if (dist > side.distance[current]) continue; // Stale duplicate
+            ++workspace.settled_;
+            if (current == target) break;
+
+            for (size_t e = offsets_[current]; e < offsets_[current + 1]; ++e) {
+                int newDist = dist + weights_[e];
+                if (side.relax(targets_[e], newDist, current)) {
+                    radix.push(static_cast<uint32_t>(newDist), targets_[e]);
+                }
+            }
+        }
+    }
+
+    // Lock-free union of the trees holding u and v: the higher root is hooked
+    // under the lower one with a CAS, retrying from fresh roots if another
+    // thread moved first. True only for the call whose CAS merged the trees.
+    static bool link(std::vector<std::atomic<VertexId>>& component, VertexId u, VertexId v) {
+        VertexId p1 = component[u].load(std::memory_order_relaxed);
+        VertexId p2 = component[v].load(std::memory_order_relaxed);
+        while (p1 != p2) {
+            VertexId high = std::max(p1, p2);
+            VertexId low = std::min(p1, p2);
+            VertexId parentOfHigh = component[high].load(std::memory_order_relaxed);
+            if (parentOfHigh == low) return false;
+            if (parentOfHigh == high &&
+                component[high].compare_exchange_strong(parentOfHigh, low, std::memory_order_relaxed)) {
+                return true;
+            }
+            p1 = component[component[high].load(std::memory_order_relaxed)].load(std::memory_order_relaxed);
+            p2 = component[low].load(std::memory_order_relaxed);
+        }
+        return false;
+    }
+    
+    // Point every vertex straight at its root
+    static void compress(std::vector<std::atomic<VertexId>>& component, ForkJoinPool& pool) {
+        pool.parallelFor(0, component.size(), 4096, [&](size_t lo, size_t hi, unsigned) {
+            for (size_t v = lo; v < hi; ++v) {
+                for (;;) {
+                    VertexId parent = component[v].load(std::memory_order_relaxed);
+                    VertexId grandparent = component[parent].load(std::memory_order_relaxed);
+                    if (parent == grandparent) break;
+                    component[v].store(grandparent, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+    
+    CsrGraph() = default;
+    
+    std::vector<size_t> offsets_;     // V + 1 entries
+    std::vector<VertexId> targets_;   // E entries
+    std::vector<int> weights_;        // E entries, parallel to targets_
+    std::vector<T> labels_;           // id -> label
+    std::unordered_map<T, VertexId> ids_; // label -> id
+};
+
+// ALT lower bounds (Goldberg & Harrelson): exact distances to and from a
+// few landmark vertices, combined through the triangle inequality:
+//   dist(v, t) >= d(L, t) - d(L, v)   and   dist(v, t) >= d(v, L) - d(t, L)
+// Landmarks are chosen greedily, each as far as possible from those already
+// picked, which puts them on the periphery where the bounds are tight. The
+// table keeps all landmark distances of a vertex together, so one heuristic
+// evaluation touches a single cache line.
+template<typename T>
+class Landmarks {
+public:
+    using VertexId = typename CsrGraph<T>::VertexId;
+    static constexpr int UNREACHABLE = CsrGraph<T>::UNREACHABLE;
+    
+    // incoming is the transpose for a directed graph, nullptr if symmetric
+    Landmarks(const CsrGraph<T>& graph, size_t count, const CsrGraph<T>* incoming = nullptr, VertexId seed = 0)
+        : symmetric_(incoming == nullptr),
+          count_(std::min(count, graph.vertexCount())),
+          stride_(count_ * (incoming ? 2 : 1)),
+          table_(graph.vertexCount() * stride_, UNREACHABLE) {
+        const size_t n = graph.vertexCount();
+        if (count_ == 0) return;
+        
+        // Farthest-first: the next landmark maximizes the distance to the
+        // closest landmark so far (the first is farthest from the seed)
+        DijkstraWorkspace workspace;
+        std::vector<int64_t> closest(n, std::numeric_limits<int64_t>::max());
+        graph.shortestPaths(seed, CsrGraph<T>::NO_VERTEX, workspace, DijkstraWorkspace::Queue::RADIX_HEAP);
+        VertexId next = farthest(workspace, n, nullptr);
+        
+        for (size_t i = 0; i < count_; ++i) {
+            landmarks_.push_back(next);
+            graph.shortestPaths(next, CsrGraph<T>::NO_VERTEX, workspace, DijkstraWorkspace::Queue::RADIX_HEAP);
+            for (VertexId v = 0; v < n; ++v) {
+                table_[v * stride_ + i] = workspace.distance(v);
+                if (workspace.distance(v) != UNREACHABLE) {
+                    closest[v] = std::min<int64_t>(closest[v], workspace.distance(v));
+                }
+            }
+            if (incoming) {
+                incoming->shortestPaths(next, CsrGraph<T>::NO_VERTEX, workspace, DijkstraWorkspace::Queue::RADIX_HEAP);
+                for (VertexId v = 0; v < n; ++v) {
+                    table_[v * stride_ + count_ + i] = workspace.distance(v);
+                }
+            }
+            next = farthest(workspace, n, &closest);
+        }
+    }
+    
+    const std::vector<VertexId>& vertices() const { return landmarks_; }
+    size_t memoryBytes() const { return table_.size() * sizeof(int); }
+    
+    // Heuristic functor for CsrGraph::aStar towards one target
+    class Bound {
+    public:
+        Bound(const Landmarks& landmarks, VertexId target) : landmarks_(landmarks), target_(target) {}
+        
+        int operator()(VertexId vertex) const { return landmarks_.lowerBound(vertex, target_); }
+        
+    private:
+        const Landmarks& landmarks_;
+        VertexId target_;
+    };
+    
+    Bound towards(VertexId target) const { return Bound(*this, target); }
+    
+    // Best triangle-inequality bound on dist(from, to), 0 if none applies
+    int lowerBound(VertexId from, VertexId to) const {
+        const int* atFrom = &table_[from * stride_];
+        const int* atTo = &table_[to * stride_];
+        int best = 0;
+        for (size_t i = 0; i < count_; ++i) {
+            if (atFrom[i] == UNREACHABLE || atTo[i] == UNREACHABLE) continue;
+            int bound = symmetric_ ? std::abs(atTo[i] - atFrom[i]) : atTo[i] - atFrom[i];
+            best = std::max(best, bound);
+        }
+        if (!symmetric_) {
+            for (size_t i = count_; i < stride_; ++i) {
+                if (atFrom[i] == UNREACHABLE || atTo[i] == UNREACHABLE) continue;
+                best = std::max(best, atFrom[i] - atTo[i]);
+            }
+        }
+        return best;
+    }
+    
+private:
+    // Reachable vertex farthest from the last search, or from the closest
+    // landmark when closest is given
+    static VertexId farthest(const DijkstraWorkspace& workspace, size_t n, const std::vector<int64_t>* closest) {
+        VertexId best = 0;
+        int64_t bestDistance = -1;
+        for (VertexId v = 0; v < n; ++v) {
+            if (workspace.distance(v) == UNREACHABLE) continue;
+            int64_t d = closest ? (*closest)[v] : workspace.distance(v);
+            if (d > bestDistance) {
+                bestDistance = d;
+                best = v;
+            }
+        }
+        return best;
+    }
+    
+    bool symmetric_;
+    size_t count_;
+    size_t stride_;
+    std::vector<int> table_;      // per vertex: d(L_i, v) for each i, then d(v, L_i) if directed
+    std::vector<VertexId> landmarks_;
+};
+
+// Pearce-Kelly dynamic topological order: every vertex holds a position, and
+// an edge u -> v that already points forward (pos(u) < pos(v)) is accepted
+// in O(1). Otherwise only the affected region between pos(v) and pos(u) is
+// searched: forward from v and backward from u, each restricted to that
+// window. Reaching u from v means the edge would close a cycle, and it is
+// rejected before anything changes; else the two visited sets are moved
+// into the positions they already occupy, backward set first. Removing
+// edges or vertices never invalidates the order.
+template<typename T>
+class IncrementalTopologicalOrder {
+public:
+    using VertexId = uint32_t;
+    static constexpr VertexId NO_VERTEX = std::numeric_limits<VertexId>::max();
+    
+    // New vertices go to the end of the order
+    VertexId addVertex(const T& label) {
+        auto found = ids_.find(label);
+        if (found != ids_.end()) return found->second;
+        VertexId id;
+        if (!freeIds_.empty()) {
+            id = freeIds_.back();
+            freeIds_.pop_back();
+            labels_[id] = label;
+        } else {
+            id = static_cast<VertexId>(labels_.size());
+            labels_.push_back(label);
+            out_.emplace_back();
+            in_.emplace_back();
+            position_.push_back(0);
+            mark_.push_back(0);
+        }
+        ids_.emplace(label, id);
+        position_[id] = static_cast<uint32_t>(slots_.size());
+        slots_.push_back(id);
+        return id;
+    }
+    
+    // Insert from -> to, reordering as needed; false (and no change) if the
+    // edge would create a cycle
+    bool addEdge(const T& from, const T& to) {
+        VertexId u = addVertex(from);
+        VertexId v = addVertex(to);
+        if (u == v) return false;
+        lastAffected_ = 0;
+        if (position_[u] > position_[v] && !reorder(u, v)) return false;
+        out_[u].push_back(v);
+        in_[v].push_back(u);
+        return true;
+    }
+    
+    void removeEdge(const T& from, const T& to) {
+        auto u = ids_.find(from), v = ids_.find(to);
+        if (u == ids_.end() || v == ids_.end()) return;
+        erase(out_[u->second], v->second);
+        erase(in_[v->second], u->second);
+    }
+    
+    void removeVertex(const T& label) {
+        auto found = ids_.find(label);
+        if (found == ids_.end()) return;
+        VertexId id = found->second;
+        for (VertexId w : out_[id]) erase(in_[w], id);
+        for (VertexId w : in_[id]) erase(out_[w], id);
+        out_[id].clear();
+        in_[id].clear();
+        slots_[position_[id]] = NO_VERTEX;
+        freeIds_.push_back(id);
+        ids_.erase(found);
+        if (++deadSlots_ > slots_.size() / 2) compact();
+    }
+    
+    // Current order, read straight off the position array
+    std::vector<T> order() const {
+        std::vector<T> result;
+        result.reserve(ids_.size());
+        for (VertexId id : slots_) {
+            if (id != NO_VERTEX) result.push_back(labels_[id]);
+        }
+        return result;
+    }
+    
+    // True if a comes before b in the current order (both must exist)
+    bool precedes(const T& a, const T& b) const {
+        return position_[ids_.at(a)] < position_[ids_.at(b)];
+    }
+    
+    size_t vertexCount() const { return ids_.size(); }
+    
+    // Vertices the last addEdge moved (0 if it needed no reordering)
+    size_t lastAffected() const { return lastAffected_; }
+    
+private:
+    // Vertices reachable from v and reaching u inside the window
+    // (pos(v), pos(u)) are collected with iterative DFS; false on a cycle
+    bool reorder(VertexId u, VertexId v) {
+        const uint32_t lower = position_[v], upper = position_[u];
+        if (++epoch_ == 0) {
+            std::fill(mark_.begin(), mark_.end(), 0);
+            epoch_ = 1;
+        }
+        
+        forward_.clear();
+        stack_.assign(1, v);
+        mark_[v] = epoch_;
+        while (!stack_.empty()) {
+            VertexId w = stack_.back();
+            stack_.pop_back();
+            forward_.push_back(w);
+            for (VertexId x : out_[w]) {
+                if (x == u) return false;
+                if (mark_[x] != epoch_ && position_[x] < upper) {
+                    mark_[x] = epoch_;
+                    stack_.push_back(x);
+                }
+            }
+        }
+        
+        backward_.clear();
+        stack_.assign(1, u);
+        mark_[u] = epoch_;
+        while (!stack_.empty()) {
+            VertexId w = stack_.back();
+            stack_.pop_back();
+            backward_.push_back(w);
+            for (VertexId x : in_[w]) {
+                if (mark_[x] != epoch_ && position_[x] > lower) {
+                    mark_[x] = epoch_;
+                    stack_.push_back(x);
+                }
+            }
+        }
+        
+        // Both sets keep their relative order; the backward set takes the
+        // lowest of the freed positions
+        auto byPosition = [this](VertexId a, VertexId b) { return position_[a] < position_[b]; };
+        std::sort(forward_.begin(), forward_.end(), byPosition);
+        std::sort(backward_.begin(), backward_.end(), byPosition);
+        freed_.clear();
+        for (VertexId w : backward_) freed_.push_back(position_[w]);
+        for (VertexId w : forward_) freed_.push_back(position_[w]);
+        std::inplace_merge(freed_.begin(), freed_.begin() + backward_.size(), freed_.end());
+        
+        size_t next = 0;
+        for (VertexId w : backward_) place(w, freed_[next++]);
+        for (VertexId w : forward_) place(w, freed_[next++]);
+        lastAffected_ = freed_.size();
+        return true;
+    }
+    
+    void place(VertexId w, uint32_t position) {
+        position_[w] = position;
+        slots_[position] = w;
+    }
+    
+    static void erase(std::vector<VertexId>& list, VertexId w) {
+        auto it = std::find(list.begin(), list.end(), w);
+        if (it == list.end()) return;
+        *it = list.back();
+        list.pop_back();
+    }
+    
+    // Drop the holes left by removed vertices
+    void compact() {
+        size_t next = 0;
+        for (VertexId id : slots_) {
+            if (id != NO_VERTEX) place(id, static_cast<uint32_t>(next++));
+        }
+        slots_.resize(next);
+        deadSlots_ = 0;
+    }
+    
+    std::unordered_map<T, VertexId> ids_;   // label -> id
+    std::vector<T> labels_;                 // id -> label
+    std::vector<std::vector<VertexId>> out_;
+    std::vector<std::vector<VertexId>> in_;
+    std::vector<uint32_t> position_;        // id -> index into slots_
+    std::vector<VertexId> slots_;           // the order; NO_VERTEX where a vertex was removed
+    std::vector<VertexId> freeIds_;
+    size_t deadSlots_ = 0;
+    size_t lastAffected_ = 0;
+    
+    // Search scratch, kept across insertions
+    std::vector<uint32_t> mark_;            // == epoch_ when visited by the current search
+    uint32_t epoch_ = 0;
+    std::vector<VertexId> stack_, forward_, backward_;
+    std::vector<uint32_t> freed_;
+};
 
 // Graph using Adjacency List representation
 template<typename T>
@@ -55,27 +1484,198 @@ public:
         }
     };
     
+    using Frozen = CsrGraph<T>;
+    using VertexId = typename Frozen::VertexId;
+    
 private:
     std::unordered_map<T, std::list<Edge>> adjList_;
     bool isDirected_;
     size_t edgeCount_;
+    bool verbose_;
+    std::shared_ptr<const Frozen> frozen_; // CSR snapshot, dropped on any change
+    std::shared_ptr<const Frozen> frozenIncoming_; // Its transpose, built on demand
+    std::shared_ptr<const Landmarks<T>> landmarks_; // ALT table for the snapshot
+    // Reused by every shortest-path query on the snapshot, including the
+    // const dijkstra() and shortestPath(): those are therefore not safe to
+    // call from several threads at once on a frozen graph
+    mutable DijkstraWorkspace workspace_;
+    std::optional<IncrementalTopologicalOrder<T>> order_; // Kept up to date by every mutation once enabled
+    
+    void thaw() {
+        frozen_.reset();
+        frozenIncoming_.reset();
+        landmarks_.reset();
+    }
+    
+    // Incoming-edge snapshot: the transpose when directed, nullptr when the
+    // snapshot is already symmetric
+    const Frozen* frozenIncoming() {
+        const Frozen& csr = freeze();
+        if (!isDirected_) return nullptr;
+        if (!frozenIncoming_) {
+            frozenIncoming_ = std::make_shared<const Frozen>(csr.transpose());
+        }
+        return frozenIncoming_.get();
+    }
+    
+    // Resolve both endpoints on the snapshot; false (with a message) if missing
+    bool frozenEndpoints(const T& start, const T& end, VertexId& source, VertexId& target) {
+        const Frozen& csr = freeze();
+        source = csr.idOf(start);
+        target = csr.idOf(end);
+        if (source == Frozen::NO_VERTEX || target == Frozen::NO_VERTEX) {
+            std::cout << "Vertex " << (source == Frozen::NO_VERTEX ? start : end) << " not found" << std::endl;
+            return false;
+        }
+        return true;
+    }
+    
+    std::pair<std::vector<T>, int> workspacePath(VertexId target) const {
+        return {toLabels(workspace_.pathTo(target)), workspace_.distance(target)};
+    }
     
 public:
     // Constructor
-    explicit Graph(bool directed = false) : isDirected_(directed), edgeCount_(0) {}
+    explicit Graph(bool directed = false) : isDirected_(directed), edgeCount_(0), verbose_(true) {}
+    
+    // Per-operation logging; turn off when bulk-loading large graphs
+    void setVerbose(bool verbose) { verbose_ = verbose; }
+    
+    // Build the CSR snapshot that all traversals use until the next mutation.
+    // Load first, freeze once, then query.
+    const Frozen& freeze() {
+        if (!frozen_) {
+            frozen_ = std::make_shared<const Frozen>(adjList_);
+        }
+        return *frozen_;
+    }
+    
+    bool isFrozen() const { return frozen_ != nullptr; }
+    
+    // Direction-optimizing BFS over the frozen snapshot (freezing first if
+    // needed). Directed graphs also get a transposed snapshot for the
+    // bottom-up steps. Level and parent are indexed by the snapshot's ids.
+    typename Frozen::BfsTree parallelBFS(const T& start, ForkJoinPool& pool) {
+        const Frozen* incoming = frozenIncoming();
+        VertexId source = frozen_->idOf(start);
+        if (source == Frozen::NO_VERTEX) {
+            std::cout << "Start vertex " << start << " not found" << std::endl;
+        }
+        return frozen_->parallelBfs(source, pool, incoming);
+    }
+    
+    // Point-to-point routing on the frozen snapshot (freezing first if
+    // needed). All three reuse one workspace owned by the graph, so repeated
+    // queries do not allocate; unreachable targets give {{}, INT_MAX}.
+    
+    // Dijkstra from both ends at once
+    std::pair<std::vector<T>, int> bidirectionalPath(const T& start, const T& end) {
+        VertexId source, target;
+        const Frozen* incoming = frozenIncoming();
+        if (!frozenEndpoints(start, end, source, target)) return {{}, std::numeric_limits<int>::max()};
+        frozen_->bidirectionalShortestPath(source, target, workspace_, incoming);
+        return workspacePath(target);
+    }
+    
+    // A* with a caller-supplied estimate(vertex) that never overestimates the
+    // remaining distance to end (e.g. straight-line distance on a map)
+    template<typename Heuristic>
+    std::pair<std::vector<T>, int> aStarPath(const T& start, const T& end, Heuristic estimate) {
+        VertexId source, target;
+        if (!frozenEndpoints(start, end, source, target)) return {{}, std::numeric_limits<int>::max()};
+        const Frozen& csr = *frozen_;
+        csr.aStar(source, target, workspace_, [&](VertexId v) { return estimate(csr.labelOf(v)); });
+        return workspacePath(target);
+    }
+    
+    // Precompute the ALT table for landmarkPath(); dropped on any mutation
+    void prepareLandmarks(size_t count) {
+        const Frozen* incoming = frozenIncoming();
+        landmarks_ = std::make_shared<const Landmarks<T>>(*frozen_, count, incoming);
+    }
+    
+    // A* guided by the landmark lower bounds (prepares 8 landmarks if needed)
+    std::pair<std::vector<T>, int> landmarkPath(const T& start, const T& end) {
+        VertexId source, target;
+        if (!frozenEndpoints(start, end, source, target)) return {{}, std::numeric_limits<int>::max()};
+        if (!landmarks_) prepareLandmarks(8);
+        frozen_->aStar(source, target, workspace_, landmarks_->towards(target));
+        return workspacePath(target);
+    }
+    
+    // Minimum spanning tree (a forest if disconnected) by parallel Boruvka on
+    // the frozen snapshot; undirected graphs only
+    std::pair<std::vector<std::tuple<T, T, int>>, int64_t> minimumSpanningTree(ForkJoinPool& pool) {
+        if (isDirected_) {
+            std::cout << "Minimum spanning tree only applies to undirected graphs" << std::endl;
+            return {};
+        }
+        const Frozen& csr = freeze();
+        auto forest = csr.minimumSpanningForest(pool);
+        std::vector<std::tuple<T, T, int>> edges;
+        edges.reserve(forest.edges.size());
+        for (const auto& edge : forest.edges) {
+            edges.emplace_back(csr.labelOf(edge.from), csr.labelOf(edge.to), edge.weight);
+        }
+        return {edges, forest.totalWeight};
+    }
+    
+    // Component label per vertex (weakly connected for directed graphs):
+    // every vertex maps to one representative vertex of its component
+    std::unordered_map<T, T> connectedComponents(ForkJoinPool& pool) {
+        const Frozen* incoming = frozenIncoming();
+        auto ids = frozen_->connectedComponents(pool, incoming);
+        std::unordered_map<T, T> components;
+        components.reserve(ids.size());
+        for (VertexId v = 0; v < ids.size(); ++v) {
+            components.emplace(frozen_->labelOf(v), frozen_->labelOf(ids[v]));
+        }
+        return components;
+    }
+    
+    // Vertices the last routing query popped from its queues
+    size_t lastSearchSettled() const { return workspace_.settledCount(); }
+    
+    // Keep a topological order up to date from now on (directed graphs
+    // only). addEdge then rejects any edge that would close a cycle, and
+    // topologicalSort() returns the maintained order without recomputing.
+    // False if the graph already has a cycle.
+    bool maintainTopologicalOrder() {
+        if (!isDirected_) {
+            std::cout << "Topological order only applies to directed graphs" << std::endl;
+            return false;
+        }
+        if (order_) return true;
+        auto initial = topologicalSort();
+        if (initial.size() != adjList_.size()) return false;
+        
+        order_.emplace();
+        for (const auto& vertex : initial) order_->addVertex(vertex);
+        for (const auto& [vertex, edges] : adjList_) {
+            for (const auto& edge : edges) order_->addEdge(vertex, edge.destination);
+        }
+        return true;
+    }
+    
+    bool maintainsTopologicalOrder() const { return order_.has_value(); }
+    
+    // The maintained order, or nullptr when not enabled
+    const IncrementalTopologicalOrder<T>* topologicalOrder() const { return order_ ? &*order_ : nullptr; }
     
     // Add vertex
     void addVertex(const T& vertex) {
         if (adjList_.find(vertex) == adjList_.end()) {
             adjList_[vertex] = std::list<Edge>();
-            std::cout << "Added vertex: " << vertex << std::endl;
+            if (order_) order_->addVertex(vertex);
+            thaw();
+            if (verbose_) std::cout << "Added vertex: " << vertex << std::endl;
         } else {
-            std::cout << "Vertex " << vertex << " already exists" << std::endl;
+            if (verbose_) std::cout << "Vertex " << vertex << " already exists" << std::endl;
         }
     }
     
-    // Add edge
-    void addEdge(const T& from, const T& to, int weight = 1) {
+    // Add edge; false only when a maintained topological order rejects it
+    bool addEdge(const T& from, const T& to, int weight = 1) {
         // Ensure vertices exist
         addVertex(from);
         addVertex(to);
@@ -85,13 +1685,19 @@ public:
         auto it = std::find_if(edges.begin(), edges.end(),
                               [&to](const Edge& e) { return e.destination == to; });
         
+        if (order_ && it == edges.end() && !order_->addEdge(from, to)) {
+            std::cout << "Rejected edge " << from << " -> " << to << ": it would create a cycle" << std::endl;
+            return false;
+        }
+        thaw();
+        
         if (it != edges.end()) {
             it->weight = weight; // Update weight if edge exists
-            std::cout << "Updated edge " << from << " -> " << to << " (weight: " << weight << ")" << std::endl;
+            if (verbose_) std::cout << "Updated edge " << from << " -> " << to << " (weight: " << weight << ")" << std::endl;
         } else {
             edges.emplace_back(to, weight);
             edgeCount_++;
-            std::cout << "Added edge " << from << " -> " << to << " (weight: " << weight << ")" << std::endl;
+            if (verbose_) std::cout << "Added edge " << from << " -> " << to << " (weight: " << weight << ")" << std::endl;
         }
         
         // For undirected graph, add reverse edge
@@ -106,6 +1712,7 @@ public:
                 reverseEdges.emplace_back(from, weight);
             }
         }
+        return true;
     }
     
     // Remove vertex
@@ -128,8 +1735,10 @@ public:
         
         // Remove the vertex
         adjList_.erase(vertex);
+        if (order_) order_->removeVertex(vertex);
+        thaw();
         
-        std::cout << "Removed vertex " << vertex << " and " << removedEdges << " edges" << std::endl;
+        if (verbose_) std::cout << "Removed vertex " << vertex << " and " << removedEdges << " edges" << std::endl;
         return true;
     }
     
@@ -147,6 +1756,8 @@ public:
         if (it != edges.end()) {
             edges.erase(it);
             edgeCount_--;
+            if (order_) order_->removeEdge(from, to);
+            thaw();
             
             // For undirected graph, remove reverse edge
             if (!isDirected_) {
@@ -154,7 +1765,7 @@ public:
                 reverseEdges.remove_if([&from](const Edge& e) { return e.destination == from; });
             }
             
-            std::cout << "Removed edge " << from << " -> " << to << std::endl;
+            if (verbose_) std::cout << "Removed edge " << from << " -> " << to << std::endl;
             return true;
         }
         
@@ -212,6 +1823,7 @@ public:
             std::cout << "Start vertex " << start << " not found" << std::endl;
             return {};
         }
+        if (frozen_) return toLabels(frozen_->dfs(frozen_->idOf(start)));
         
         std::vector<T> result;
         std::unordered_set<T> visited;
@@ -267,6 +1879,8 @@ public:
             return {};
         }
         
+        if (frozen_) return toLabels(frozen_->dfsPreorder(frozen_->idOf(start)));
+        
         std::vector<T> result;
         std::unordered_set<T> visited;
         DFSRecursiveHelper(start, visited, result);
@@ -279,6 +1893,7 @@ public:
             std::cout << "Start vertex " << start << " not found" << std::endl;
             return {};
         }
+        if (frozen_) return toLabels(frozen_->bfs(frozen_->idOf(start)));
         
         std::vector<T> result;
         std::unordered_set<T> visited;
@@ -305,107 +1920,54 @@ public:
         return result;
     }
     
-    // Dijkstra's shortest path algorithm
+    // Dijkstra's shortest path algorithm (binary heap with lazy deletion;
+    // unreachable vertices keep distance INT_MAX)
     std::unordered_map<T, int> dijkstra(const T& start) const {
-        std::unordered_map<T, int> distances;
-        std::unordered_set<T> unvisited;
-        
-        // Initialize distances
-        for (const auto& [vertex, edges] : adjList_) {
-            distances[vertex] = (vertex == start) ? 0 : std::numeric_limits<int>::max();
-            unvisited.insert(vertex);
-        }
-        
-        while (!unvisited.empty()) {
-            // Find vertex with minimum distance
-            T current;
-            int minDist = std::numeric_limits<int>::max();
-            for (const T& vertex : unvisited) {
-                if (distances[vertex] < minDist) {
-                    minDist = distances[vertex];
-                    current = vertex;
-                }
-            }
-            
-            if (minDist == std::numeric_limits<int>::max()) break; // Unreachable vertices
-            
-            unvisited.erase(current);
-            
-            // Update distances to neighbors
-            if (adjList_.find(current) != adjList_.end()) {
-                for (const auto& edge : adjList_.at(current)) {
-                    if (unvisited.find(edge.destination) != unvisited.end()) {
-                        int newDist = distances[current] + edge.weight;
-                        if (newDist < distances[edge.destination]) {
-                            distances[edge.destination] = newDist;
-                        }
-                    }
-                }
-            }
-        }
+        if (frozen_) return frozenDijkstra(start);
         
-        return distances;
-    }
-    
-    // Find shortest path between two vertices
-    std::pair<std::vector<T>, int> shortestPath(const T& start, const T& end) const {
         std::unordered_map<T, int> distances;
-        std::unordered_map<T, T> previous;
-        std::unordered_set<T> unvisited;
-        
-        // Initialize
         for (const auto& [vertex, edges] : adjList_) {
-            distances[vertex] = (vertex == start) ? 0 : std::numeric_limits<int>::max();
-            unvisited.insert(vertex);
+            distances[vertex] = std::numeric_limits<int>::max();
         }
-        
-        while (!unvisited.empty()) {
-            // Find vertex with minimum distance
-            T current;
-            int minDist = std::numeric_limits<int>::max();
-            for (const T& vertex : unvisited) {
-                if (distances[vertex] < minDist) {
-                    minDist = distances[vertex];
-                    current = vertex;
-                }
-            }
-            
-            if (minDist == std::numeric_limits<int>::max()) break;
-            if (current == end) break; // Found target
-            
-            unvisited.erase(current);
-            
-            // Update neighbors
-            if (adjList_.find(current) != adjList_.end()) {
-                for (const auto& edge : adjList_.at(current)) {
-                    if (unvisited.find(edge.destination) != unvisited.end()) {
-                        int newDist = distances[current] + edge.weight;
-                        if (newDist < distances[edge.destination]) {
-                            distances[edge.destination] = newDist;
-                            previous[edge.destination] = current;
-                        }
-                    }
-                }
-            }
+        if (adjList_.find(start) == adjList_.end()) return distances;
+        
+        runDijkstra(start, nullptr, distances, nullptr);
+        return distances;
+    }
+    
+    // Find shortest path between two vertices; the search stops as soon as
+    // end is settled
+    std::pair<std::vector<T>, int> shortestPath(const T& start, const T& end) const {
+        if (frozen_) return frozenShortestPath(start, end);
+        if (adjList_.find(start) == adjList_.end() || adjList_.find(end) == adjList_.end()) {
+            return {{}, std::numeric_limits<int>::max()};
         }
         
+        std::unordered_map<T, int> distances;
+        std::unordered_map<T, T> previous;
+        runDijkstra(start, &end, distances, &previous);
+        
         // Reconstruct path
         std::vector<T> path;
-        if (distances[end] != std::numeric_limits<int>::max()) {
-            T current = end;
-            while (previous.find(current) != previous.end()) {
-                path.push_back(current);
-                current = previous[current];
-            }
-            path.push_back(start);
-            std::reverse(path.begin(), path.end());
+        auto found = distances.find(end);
+        if (found == distances.end()) {
+            return {path, std::numeric_limits<int>::max()};
         }
-        
-        return {path, distances[end]};
+        T current = end;
+        while (previous.find(current) != previous.end()) {
+            path.push_back(current);
+            current = previous[current];
+        }
+        path.push_back(start);
+        std::reverse(path.begin(), path.end());
+        return {path, found->second};
     }
     
     // Detect cycle in directed graph using DFS
     bool hasCycleDFS() const {
+        if (order_) return false; // Cycle-closing edges were rejected
+        if (frozen_) return frozen_->hasCycle();
+        
         std::unordered_set<T> visited;
         std::unordered_set<T> recursionStack;
         
@@ -442,6 +2004,66 @@ private:
         return false;
     }
     
+    // Label-keyed Dijkstra over the adjacency lists. Distances are written
+    // only for reached vertices; a vertex absent from distances is unreached.
+    void runDijkstra(const T& start, const T* end, std::unordered_map<T, int>& distances,
+                     std::unordered_map<T, T>* previous) const {
+        using Entry = std::pair<int, T>;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+        
+        distances[start] = 0;
+        heap.emplace(0, start);
+        while (!heap.empty()) {
+            auto [dist, current] = heap.top();
+            heap.pop();
+            if (dist > distances[current]) continue; // Stale entry
+            if (end && current == *end) break;
+            
+            for (const auto& edge : adjList_.at(current)) {
+                int newDist = dist + edge.weight;
+                auto known = distances.find(edge.destination);
+                if (known == distances.end() || newDist < known->second) {
+                    distances[edge.destination] = newDist;
+                    if (previous) (*previous)[edge.destination] = current;
+                    heap.emplace(newDist, edge.destination);
+                }
+            }
+        }
+    }
+    
+    std::vector<T> toLabels(const std::vector<VertexId>& ids) const {
+        std::vector<T> labels;
+        labels.reserve(ids.size());
+        for (VertexId id : ids) {
+            labels.push_back(frozen_->labelOf(id));
+        }
+        return labels;
+    }
+    
+    std::unordered_map<T, int> frozenDijkstra(const T& start) const {
+        std::unordered_map<T, int> distances;
+        VertexId source = frozen_->idOf(start);
+        if (source == Frozen::NO_VERTEX) return distances;
+        
+        frozen_->shortestPaths(source, Frozen::NO_VERTEX, workspace_);
+        distances.reserve(frozen_->vertexCount());
+        for (VertexId v = 0; v < frozen_->vertexCount(); ++v) {
+            distances.emplace(frozen_->labelOf(v), workspace_.distance(v));
+        }
+        return distances;
+    }
+    
+    std::pair<std::vector<T>, int> frozenShortestPath(const T& start, const T& end) const {
+        VertexId source = frozen_->idOf(start);
+        VertexId target = frozen_->idOf(end);
+        if (source == Frozen::NO_VERTEX || target == Frozen::NO_VERTEX) {
+            return {{}, std::numeric_limits<int>::max()};
+        }
+        
+        frozen_->shortestPaths(source, target, workspace_);
+        return {toLabels(workspace_.pathTo(target)), workspace_.distance(target)};
+    }
+    
 public:
     // Topological sort (only for DAGs)
     std::vector<T> topologicalSort() const {
@@ -450,11 +2072,15 @@ public:
             return {};
         }
         
+        if (order_) return order_->order();
+        
         if (hasCycleDFS()) {
             std::cout << "Graph has cycles - topological sort not possible" << std::endl;
             return {};
         }
         
+        if (frozen_) return toLabels(frozen_->topologicalOrder());
+        
         std::unordered_map<T, int> inDegree;
         std::queue<T> queue;
         std::vector<T> result;
@@ -566,7 +2192,9 @@ public:
     void clear() {
         adjList_.clear();
         edgeCount_ = 0;
-        std::cout << "Graph cleared" << std::endl;
+        thaw();
+        if (order_) order_.emplace(); // Still maintained, now for the empty graph
+        if (verbose_) std::cout << "Graph cleared" << std::endl;
     }
 };
 
@@ -927,7 +2555,996 @@ void demonstratePerformanceCharacteristics() {
     std::cout << "  ✅ Working with weighted graphs extensively" << std::endl;
 }
 
-int main() {
+void demonstrateFrozenGraph() {
+    printSeparator("FROZEN GRAPH (CSR SNAPSHOT)");
+    
+    Graph<std::string> roadNetwork(false);
+    roadNetwork.setVerbose(false);
+    roadNetwork.addEdge("Downtown", "Airport", 15);
+    roadNetwork.addEdge("Downtown", "University", 8);
+    roadNetwork.addEdge("Airport", "Mall", 12);
+    roadNetwork.addEdge("University", "Mall", 6);
+    roadNetwork.addEdge("University", "Hospital", 10);
+    roadNetwork.addEdge("Mall", "Hospital", 4);
+    
+    auto listBfs = roadNetwork.BFS("Downtown");
+    auto [listPath, listDist] = roadNetwork.shortestPath("Downtown", "Hospital");
+    
+    const auto& csr = roadNetwork.freeze();
+    std::cout << "Frozen: " << csr.vertexCount() << " dense ids, "
+              << csr.edgeCount() << " CSR edge slots" << std::endl;
+    for (CsrGraph<std::string>::VertexId v = 0; v < csr.vertexCount(); ++v) {
+        std::cout << "  id " << v << " = " << std::left << std::setw(11) << csr.labelOf(v)
+                  << std::right << " edges [" << csr.edgesBegin(v) << ", " << csr.edgesEnd(v) << ")" << std::endl;
+    }
+    
+    auto csrBfs = roadNetwork.BFS("Downtown");
+    auto [csrPath, csrDist] = roadNetwork.shortestPath("Downtown", "Hospital");
+    std::cout << "BFS from Downtown: ";
+    for (size_t i = 0; i < csrBfs.size(); ++i) {
+        std::cout << csrBfs[i] << (i + 1 < csrBfs.size() ? " -> " : "");
+    }
+    std::cout << "\nDowntown to Hospital: ";
+    for (size_t i = 0; i < csrPath.size(); ++i) {
+        std::cout << csrPath[i] << (i + 1 < csrPath.size() ? " -> " : "");
+    }
+    std::cout << " (" << csrDist << " km)" << std::endl;
+    std::cout << "Same results as the adjacency lists: "
+              << (listBfs == csrBfs && listPath == csrPath && listDist == csrDist ? "Yes" : "No") << std::endl;
+    
+    roadNetwork.addEdge("Airport", "Hospital", 9);
+    std::cout << "After addEdge the snapshot is dropped, frozen: "
+              << (roadNetwork.isFrozen() ? "Yes" : "No") << std::endl;
+}
+
+void demonstrateParallelBfs() {
+    printSeparator("DIRECTION-OPTIMIZING PARALLEL BFS");
+    
+    Graph<std::string> follows(true);
+    follows.setVerbose(false);
+    follows.addEdge("Alice", "Bob");
+    follows.addEdge("Alice", "Charlie");
+    follows.addEdge("Bob", "Diana");
+    follows.addEdge("Charlie", "Diana");
+    follows.addEdge("Diana", "Eve");
+    follows.addEdge("Eve", "Alice");
+    follows.addEdge("Frank", "Eve");
+    
+    ForkJoinPool pool(2);
+    auto tree = follows.parallelBFS("Alice", pool);
+    const auto& csr = follows.freeze();
+    
+    std::cout << "Who Alice reaches through 'follows' (" << pool.size() << " threads, "
+              << tree.topDownSteps << " top-down / " << tree.bottomUpSteps << " bottom-up steps):" << std::endl;
+    for (CsrGraph<std::string>::VertexId v = 0; v < csr.vertexCount(); ++v) {
+        std::cout << "  " << std::left << std::setw(8) << csr.labelOf(v) << std::right;
+        if (tree.level[v] < 0) {
+            std::cout << "unreached" << std::endl;
+        } else {
+            std::cout << "level " << tree.level[v] << ", parent " << csr.labelOf(tree.parent[v]) << std::endl;
+        }
+    }
+    std::cout << "Reached " << tree.reached << " vertices, queue BFS reached "
+              << follows.BFS("Alice").size() << std::endl;
+}
+
+void demonstrateRouting() {
+    printSeparator("POINT-TO-POINT ROUTING");
+    
+    Graph<std::string> roadNetwork(false);
+    roadNetwork.setVerbose(false);
+    roadNetwork.addEdge("Downtown", "Airport", 15);
+    roadNetwork.addEdge("Downtown", "University", 8);
+    roadNetwork.addEdge("Airport", "Mall", 12);
+    roadNetwork.addEdge("University", "Mall", 6);
+    roadNetwork.addEdge("University", "Hospital", 10);
+    roadNetwork.addEdge("Mall", "Hospital", 4);
+    
+    // Map coordinates in km; no road is shorter than the straight line, so
+    // the straight-line distance to the Hospital never overestimates
+    std::unordered_map<std::string, std::pair<double, double>> position = {
+        {"Downtown", {0, 0}}, {"Airport", {12, -8}}, {"University", {7, 3}},
+        {"Mall", {12, 4}}, {"Hospital", {15, 6}}};
+    auto straightLine = [&](const std::string& city) {
+        double dx = position[city].first - position["Hospital"].first;
+        double dy = position[city].second - position["Hospital"].second;
+        return static_cast<int>(std::sqrt(dx * dx + dy * dy));
+    };
+    
+    auto show = [&](const std::string& method, const std::pair<std::vector<std::string>, int>& route) {
+        std::cout << std::left << std::setw(24) << method << std::right;
+        for (size_t i = 0; i < route.first.size(); ++i) {
+            std::cout << route.first[i] << (i + 1 < route.first.size() ? " -> " : "");
+        }
+        std::cout << " (" << route.second << " km, " << roadNetwork.lastSearchSettled() << " settled)" << std::endl;
+    };
+    
+    auto plain = roadNetwork.shortestPath("Downtown", "Hospital");
+    std::cout << std::left << std::setw(24) << "Dijkstra" << std::right;
+    for (size_t i = 0; i < plain.first.size(); ++i) {
+        std::cout << plain.first[i] << (i + 1 < plain.first.size() ? " -> " : "");
+    }
+    std::cout << " (" << plain.second << " km)" << std::endl;
+    show("Bidirectional Dijkstra", roadNetwork.bidirectionalPath("Downtown", "Hospital"));
+    show("A*, straight line", roadNetwork.aStarPath("Downtown", "Hospital", straightLine));
+    roadNetwork.prepareLandmarks(2);
+    show("A*, 2 ALT landmarks", roadNetwork.landmarkPath("Downtown", "Hospital"));
+}
+
+void demonstrateSpanningTreeAndComponents() {
+    printSeparator("MINIMUM SPANNING TREE AND COMPONENTS");
+    
+    Graph<std::string> roadNetwork(false);
+    roadNetwork.setVerbose(false);
+    roadNetwork.addEdge("Downtown", "Airport", 15);
+    roadNetwork.addEdge("Downtown", "University", 8);
+    roadNetwork.addEdge("Airport", "Mall", 12);
+    roadNetwork.addEdge("University", "Mall", 6);
+    roadNetwork.addEdge("University", "Hospital", 10);
+    roadNetwork.addEdge("Mall", "Hospital", 4);
+    // A separate island
+    roadNetwork.addEdge("Harbor", "Lighthouse", 3);
+    
+    ForkJoinPool pool(2);
+    auto [edges, total] = roadNetwork.minimumSpanningTree(pool);
+    std::cout << "Cheapest roads keeping every place connected (Boruvka):" << std::endl;
+    for (const auto& [from, to, weight] : edges) {
+        std::cout << "  " << from << " - " << to << " (" << weight << " km)" << std::endl;
+    }
+    std::cout << "Total: " << total << " km" << std::endl;
+    
+    auto components = roadNetwork.connectedComponents(pool);
+    std::cout << "\nComponent of each place:" << std::endl;
+    for (const auto& [place, representative] : components) {
+        std::cout << "  " << std::left << std::setw(11) << place << std::right << "-> " << representative << std::endl;
+    }
+}
+
+void demonstrateIncrementalTopologicalOrder() {
+    printSeparator("INCREMENTAL TOPOLOGICAL ORDER");
+    
+    Graph<std::string> projectTasks(true);
+    projectTasks.setVerbose(false);
+    projectTasks.maintainTopologicalOrder();
+    
+    auto showOrder = [&projectTasks]() {
+        auto order = projectTasks.topologicalSort();
+        for (size_t i = 0; i < order.size(); ++i) {
+            std::cout << order[i] << (i + 1 < order.size() ? " -> " : "\n");
+        }
+    };
+    
+    // Tasks arrive before we know how they depend on each other
+    for (const char* task : {"Deployment", "Testing", "Coding", "Design", "Analysis"}) {
+        projectTasks.addVertex(task);
+    }
+    std::cout << "Order before any dependency: ";
+    showOrder();
+    
+    projectTasks.addEdge("Analysis", "Design");
+    projectTasks.addEdge("Design", "Coding");
+    projectTasks.addEdge("Coding", "Testing");
+    projectTasks.addEdge("Testing", "Deployment");
+    std::cout << "After four dependencies:     ";
+    showOrder();
+    
+    std::cout << "\nAdding Deployment -> Analysis:" << std::endl;
+    bool added = projectTasks.addEdge("Deployment", "Analysis");
+    std::cout << "Accepted: " << (added ? "yes" : "no") << ", has cycle: "
+              << (projectTasks.hasCycleDFS() ? "yes" : "no") << std::endl;
+    
+    projectTasks.addEdge("Analysis", "Documentation");
+    projectTasks.addEdge("Documentation", "Coding");
+    std::cout << "With documentation before coding: ";
+    showOrder();
+    
+    projectTasks.clear();
+    bool reversed = projectTasks.addEdge("Deployment", "Analysis");
+    std::cout << "\nAfter clear(), Deployment -> Analysis accepted: " << (reversed ? "yes" : "no") << ", order: ";
+    showOrder();
+}
+
+// ============================================================================
+// BENCHMARKS
+// ============================================================================
+
+using BenchClock = std::chrono::steady_clock;
+
+double millisecondsSince(BenchClock::time_point start) {
+    return std::chrono::duration<double, std::milli>(BenchClock::now() - start).count();
+}
+
+// Bytes currently allocated from the heap, including mmap'd blocks
+size_t heapBytesInUse() {
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+#else
+    return 0;
+#endif
+}
+
+std::string formatMegabytes(size_t bytes) {
+    if (bytes == 0) return "n/a";
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(1) << bytes / (1024.0 * 1024.0) << " MB";
+    return out.str();
+}
+
+// Random directed graph with integer labels 0..vertices-1 and weights 1..100
+Graph<int> generateRandomGraph(size_t vertices, size_t edges, uint64_t seed) {
+    Graph<int> graph(true);
+    graph.setVerbose(false);
+    std::mt19937_64 rng(seed);
+    std::uniform_int_distribution<int> pickVertex(0, static_cast<int>(vertices) - 1);
+    std::uniform_int_distribution<int> pickWeight(1, 100);
+    
+    for (size_t v = 0; v < vertices; ++v) {
+        graph.addVertex(static_cast<int>(v));
+    }
+    for (size_t e = 0; e < edges; ++e) {
+        graph.addEdge(pickVertex(rng), pickVertex(rng), pickWeight(rng));
+    }
+    return graph;
+}
+
+// R-MAT edges (Chakrabarti, Zhan, Faloutsos) with the Graph500 parameters
+// a = 0.57, b = c = 0.19: 2^scale vertices and edgeFactor * 2^scale edges,
+// weights 1..100. Vertex ids are shuffled so the hubs are spread out, and
+// self-loops are dropped.
+std::vector<CsrGraph<int>::WeightedEdge> generateRmatEdges(unsigned scale, unsigned edgeFactor, uint64_t seed) {
+    using VertexId = CsrGraph<int>::VertexId;
+    const size_t vertices = size_t(1) << scale;
+    std::mt19937_64 rng(seed);
+    auto uniform = [&rng]() { return (rng() >> 11) * 0x1.0p-53; };
+    
+    std::vector<VertexId> shuffle(vertices);
+    for (size_t v = 0; v < vertices; ++v) shuffle[v] = static_cast<VertexId>(v);
+    std::shuffle(shuffle.begin(), shuffle.end(), rng);
+    
+    std::vector<CsrGraph<int>::WeightedEdge> edges;
+    edges.reserve(vertices * edgeFactor);
+    for (size_t i = 0; i < vertices * edgeFactor; ++i) {
+        VertexId from = 0;
+        VertexId to = 0;
+        for (unsigned bit = 0; bit < scale; ++bit) {
+            double r = uniform();
+            bool right = r >= 0.57 && (r < 0.76 || r >= 0.95); // quadrant b or d
+            bool down = r >= 0.76;                               // quadrant c or d
+            from |= VertexId(down) << bit;
+            to |= VertexId(right) << bit;
+        }
+        if (from == to) continue;
+        edges.push_back({shuffle[from], shuffle[to], static_cast<int>(rng() % 100) + 1});
+    }
+    return edges;
+}
+
+// Undirected side x side 4-neighbour grid with weights 1..100, vertex r*side+c
+Graph<int> generateGridGraph(size_t side, uint64_t seed) {
+    Graph<int> graph(false);
+    graph.setVerbose(false);
+    std::mt19937_64 rng(seed);
+    std::uniform_int_distribution<int> pickWeight(1, 100);
+    
+    for (size_t v = 0; v < side * side; ++v) {
+        graph.addVertex(static_cast<int>(v));
+    }
+    for (size_t r = 0; r < side; ++r) {
+        for (size_t c = 0; c < side; ++c) {
+            int v = static_cast<int>(r * side + c);
+            if (c + 1 < side) graph.addEdge(v, v + 1, pickWeight(rng));
+            if (r + 1 < side) graph.addEdge(v, v + static_cast<int>(side), pickWeight(rng));
+        }
+    }
+    return graph;
+}
+
+// Adjacency lists vs CSR: memory, BFS and Dijkstra on the same random graph.
+// Both Dijkstras use a binary heap, so the gap is layout alone: hashed labels
+// and per-vertex edge lists versus dense ids and contiguous arrays.
+void benchmarkCsrLayout(size_t edges) {
+    printSeparator("BENCHMARK: ADJACENCY LISTS VS CSR");
+    
+    struct Row {
+        std::string layout;
+        size_t vertices;
+        size_t edges;
+        std::string memory;
+        double bfsMs;
+        double dijkstraMs;
+    };
+    std::vector<Row> rows;
+    
+    for (size_t targetEdges : {std::min<size_t>(edges, 100000), edges}) {
+        size_t vertices = std::max<size_t>(targetEdges / 10, 2);
+        std::cout << "Generating " << vertices << " vertices / " << targetEdges << " edges..." << std::endl;
+        
+        size_t before = heapBytesInUse();
+        Graph<int> graph = generateRandomGraph(vertices, targetEdges, 42);
+        size_t listBytes = heapBytesInUse() - before;
+        
+        auto start = BenchClock::now();
+        size_t reached = graph.BFS(0).size();
+        double listBfs = millisecondsSince(start);
+        
+        start = BenchClock::now();
+        graph.dijkstra(0);
+        double listDijkstra = millisecondsSince(start);
+        rows.push_back({"adjacency lists", vertices, graph.getEdgeCount(), formatMegabytes(listBytes),
+                        listBfs, listDijkstra});
+        
+        before = heapBytesInUse();
+        start = BenchClock::now();
+        const auto& csr = graph.freeze();
+        double freezeMs = millisecondsSince(start);
+        size_t csrBytes = heapBytesInUse() - before;
+        std::cout << "  freeze() took " << std::fixed << std::setprecision(1) << freezeMs
+                  << " ms, BFS reaches " << reached << " vertices" << std::endl;
+        
+        start = BenchClock::now();
+        graph.BFS(0);
+        double labelBfs = millisecondsSince(start);
+        start = BenchClock::now();
+        graph.dijkstra(0);
+        double labelDijkstra = millisecondsSince(start);
+        rows.push_back({"CSR, label API", vertices, csr.edgeCount(), formatMegabytes(csrBytes),
+                        labelBfs, labelDijkstra});
+        
+        auto source = csr.idOf(0);
+        start = BenchClock::now();
+        csr.bfs(source);
+        double idBfs = millisecondsSince(start);
+        start = BenchClock::now();
+        csr.dijkstra(source);
+        double idDijkstra = millisecondsSince(start);
+        rows.push_back({"CSR, dense ids", vertices, csr.edgeCount(), "(same)", idBfs, idDijkstra});
+    }
+    
+    std::cout << "\n" << std::left << std::setw(17) << "layout" << std::right
+              << std::setw(10) << "vertices" << std::setw(11) << "edges"
+              << std::setw(11) << "memory" << std::setw(11) << "BFS ms"
+              << std::setw(14) << "Dijkstra ms" << std::endl;
+    for (const auto& row : rows) {
+        std::cout << std::left << std::setw(17) << row.layout << std::right
+                  << std::setw(10) << row.vertices << std::setw(11) << row.edges
+                  << std::setw(11) << row.memory << std::fixed << std::setprecision(1)
+                  << std::setw(11) << row.bfsMs << std::setw(14) << row.dijkstraMs << std::endl;
+    }
+    std::cout << "\nCSR memory is the snapshot alone (offsets, targets, weights and the id<->label map);" << std::endl;
+    std::cout << "the label API rows include translating results back into labels." << std::endl;
+}
+
+// Priority queues for Dijkstra on a grid and a random sparse graph: one full
+// single-source run per source, then point-to-point queries with early exit.
+// The lazy std::priority_queue variant allocates its arrays per query; the
+// indexed 4-ary heap and radix heap reuse one DijkstraWorkspace.
+void benchmarkDijkstraQueues(size_t vertices, size_t queries) {
+    printSeparator("BENCHMARK: DIJKSTRA PRIORITY QUEUES");
+    
+    struct Row {
+        std::string graph;
+        std::string queue;
+        double fullMs;
+        double queryUs;
+        double settled;
+    };
+    std::vector<Row> rows;
+    using Queue = DijkstraWorkspace::Queue;
+    const size_t FULL_RUNS = 3;
+    
+    size_t side = static_cast<size_t>(std::sqrt(static_cast<double>(vertices)));
+    for (int kind = 0; kind < 2; ++kind) {
+        std::string name = kind == 0 ? "grid " + std::to_string(side) + "x" + std::to_string(side)
+                                     : "random, out-degree 8";
+        std::cout << "Generating " << name << "..." << std::endl;
+        Graph<int> graph = kind == 0 ? generateGridGraph(side, 7) : generateRandomGraph(vertices, vertices * 8, 7);
+        
+        // The adjacency-list path now uses a heap too; one full run for scale
+        auto start = BenchClock::now();
+        graph.dijkstra(0);
+        rows.push_back({name, "adjacency lists, label heap", millisecondsSince(start), -1, -1});
+        
+        const auto& csr = graph.freeze();
+        std::mt19937_64 rng(11);
+        std::uniform_int_distribution<CsrGraph<int>::VertexId> pick(0, static_cast<CsrGraph<int>::VertexId>(csr.vertexCount() - 1));
+        std::vector<std::pair<CsrGraph<int>::VertexId, CsrGraph<int>::VertexId>> pairs(queries);
+        for (auto& [from, to] : pairs) {
+            from = pick(rng);
+            to = pick(rng);
+        }
+        
+        // Lazy binary heap, fresh arrays every call
+        std::vector<int> reference;
+        start = BenchClock::now();
+        for (size_t run = 0; run < FULL_RUNS; ++run) {
+            reference = csr.dijkstra(pairs[run % pairs.size()].first);
+        }
+        double fullMs = millisecondsSince(start) / FULL_RUNS;
+        std::vector<CsrGraph<int>::VertexId> previous;
+        int64_t checksum = 0;
+        start = BenchClock::now();
+        for (const auto& [from, to] : pairs) {
+            checksum += csr.dijkstra(from, to, &previous)[to];
+        }
+        rows.push_back({name, "std::priority_queue (lazy)", fullMs,
+                        millisecondsSince(start) * 1000.0 / pairs.size(), -1});
+        
+        DijkstraWorkspace workspace;
+        for (Queue queue : {Queue::DARY_HEAP, Queue::RADIX_HEAP}) {
+            start = BenchClock::now();
+            for (size_t run = 0; run < FULL_RUNS; ++run) {
+                csr.shortestPaths(pairs[run % pairs.size()].first, CsrGraph<int>::NO_VERTEX, workspace, queue);
+            }
+            fullMs = millisecondsSince(start) / FULL_RUNS;
+            
+            bool agrees = true;
+            for (CsrGraph<int>::VertexId v = 0; v < csr.vertexCount(); ++v) {
+                agrees = agrees && workspace.distance(v) == reference[v];
+            }
+            
+            int64_t sum = 0;
+            size_t settled = 0;
+            start = BenchClock::now();
+            for (const auto& [from, to] : pairs) {
+                csr.shortestPaths(from, to, workspace, queue);
+                sum += workspace.distance(to);
+                settled += workspace.settledCount();
+            }
+            double queryUs = millisecondsSince(start) * 1000.0 / pairs.size();
+            if (!agrees || sum != checksum) {
+                std::cout << "  distance mismatch for " << (queue == Queue::DARY_HEAP ? "4-ary" : "radix") << " heap!" << std::endl;
+            }
+            rows.push_back({name, queue == Queue::DARY_HEAP ? "indexed 4-ary heap + workspace" : "radix heap + workspace",
+                            fullMs, queryUs, static_cast<double>(settled) / pairs.size()});
+        }
+    }
+    
+    std::cout << "\n" << std::left << std::setw(22) << "graph" << std::setw(32) << "queue" << std::right
+              << std::setw(12) << "full ms" << std::setw(14) << "query us" << std::setw(12) << "settled" << std::endl;
+    for (const auto& row : rows) {
+        std::cout << std::left << std::setw(22) << row.graph << std::setw(32) << row.queue << std::right
+                  << std::fixed << std::setprecision(1) << std::setw(12) << row.fullMs;
+        if (row.queryUs < 0) {
+            std::cout << std::setw(14) << "-";
+        } else {
+            std::cout << std::setw(14) << row.queryUs;
+        }
+        if (row.settled < 0) {
+            std::cout << std::setw(12) << "-";
+        } else {
+            std::cout << std::setw(12) << std::setprecision(0) << row.settled;
+        }
+        std::cout << std::endl;
+    }
+    std::cout << "\nfull = one whole single-source run; query = point-to-point with early exit," << std::endl;
+    std::cout << "averaged over " << queries << " random pairs; settled = vertices popped per query." << std::endl;
+}
+
+// Point-to-point query latency on a side x side grid: plain Dijkstra with
+// early exit, bidirectional Dijkstra, A* with a Manhattan bound and ALT with
+// several landmark counts, all sharing one workspace. Every method must
+// return the plain Dijkstra distance for every pair.
+void benchmarkRouting(size_t vertices, size_t queries) {
+    printSeparator("BENCHMARK: POINT-TO-POINT ROUTING");
+    using Csr = CsrGraph<int>;
+    
+    size_t side = static_cast<size_t>(std::sqrt(static_cast<double>(vertices)));
+    std::cout << "Generating grid " << side << "x" << side << " (weights 1..100)..." << std::endl;
+    Graph<int> graph = generateGridGraph(side, 5);
+    const Csr& csr = graph.freeze();
+    
+    std::mt19937_64 rng(17);
+    std::vector<std::pair<Csr::VertexId, Csr::VertexId>> pairs(queries);
+    for (auto& [from, to] : pairs) {
+        from = static_cast<Csr::VertexId>(rng() % csr.vertexCount());
+        to = static_cast<Csr::VertexId>(rng() % csr.vertexCount());
+    }
+    
+    DijkstraWorkspace workspace;
+    std::vector<int> expected;
+    for (const auto& [from, to] : pairs) {
+        csr.shortestPaths(from, to, workspace);
+        expected.push_back(workspace.distance(to));
+    }
+    
+    struct Row {
+        std::string method;
+        double meanMs;
+        double p99Ms;
+        double settled;
+        bool exact;
+    };
+    std::vector<Row> rows;
+    auto measure = [&](const std::string& method, const std::function<void(Csr::VertexId, Csr::VertexId)>& query) {
+        std::vector<double> latency;
+        size_t settled = 0;
+        bool exact = true;
+        for (size_t i = 0; i < pairs.size(); ++i) {
+            auto start = BenchClock::now();
+            query(pairs[i].first, pairs[i].second);
+            latency.push_back(millisecondsSince(start));
+            settled += workspace.settledCount();
+            exact = exact && workspace.distance(pairs[i].second) == expected[i] &&
+                    (expected[i] == Csr::UNREACHABLE || workspace.pathTo(pairs[i].second).front() == pairs[i].first);
+        }
+        double total = 0;
+        for (double ms : latency) total += ms;
+        std::sort(latency.begin(), latency.end());
+        rows.push_back({method, total / latency.size(), latency[(latency.size() - 1) * 99 / 100],
+                        static_cast<double>(settled) / pairs.size(), exact});
+    };
+    
+    measure("Dijkstra, 4-ary heap", [&](Csr::VertexId s, Csr::VertexId t) { csr.shortestPaths(s, t, workspace); });
+    measure("Dijkstra, radix heap", [&](Csr::VertexId s, Csr::VertexId t) {
+        csr.shortestPaths(s, t, workspace, DijkstraWorkspace::Queue::RADIX_HEAP);
+    });
+    measure("bidirectional Dijkstra", [&](Csr::VertexId s, Csr::VertexId t) {
+        csr.bidirectionalShortestPath(s, t, workspace);
+    });
+    measure("A*, Manhattan x min weight", [&](Csr::VertexId s, Csr::VertexId t) {
+        int goal = csr.labelOf(t);
+        int goalRow = goal / static_cast<int>(side);
+        int goalCol = goal % static_cast<int>(side);
+        csr.aStar(s, t, workspace, [&](Csr::VertexId v) {
+            int label = csr.labelOf(v);
+            return std::abs(label / static_cast<int>(side) - goalRow) + std::abs(label % static_cast<int>(side) - goalCol);
+        });
+    });
+    for (size_t count : {4, 8, 16}) {
+        auto start = BenchClock::now();
+        Landmarks<int> landmarks(csr, count);
+        double buildMs = millisecondsSince(start);
+        std::ostringstream name;
+        name << "ALT, " << count << " landmarks";
+        measure(name.str(), [&](Csr::VertexId s, Csr::VertexId t) { csr.aStar(s, t, workspace, landmarks.towards(t)); });
+        std::cout << "  " << count << " landmarks: " << std::fixed << std::setprecision(0) << buildMs
+                  << " ms to build, " << formatMegabytes(landmarks.memoryBytes()) << std::endl;
+    }
+    
+    double baseline = rows.front().meanMs;
+    std::cout << "\n" << std::left << std::setw(28) << "method" << std::right << std::setw(10) << "mean ms"
+              << std::setw(10) << "p99 ms" << std::setw(10) << "speedup" << std::setw(12) << "settled"
+              << std::setw(8) << "exact" << std::endl;
+    for (const auto& row : rows) {
+        std::cout << std::left << std::setw(28) << row.method << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(10) << row.meanMs << std::setw(10) << row.p99Ms
+                  << std::setw(9) << baseline / row.meanMs << "x" << std::setprecision(0)
+                  << std::setw(12) << row.settled << std::setw(8) << (row.exact ? "yes" : "NO") << std::endl;
+    }
+    std::cout << "\n" << queries << " random vertex pairs; settled = vertices popped per query." << std::endl;
+}
+
+// Thread counts for the parallel benchmarks: powers of two up to max(8, cores)
+std::vector<unsigned> benchmarkThreadCounts(unsigned maxThreads) {
+    unsigned limit = maxThreads ? maxThreads : std::max(8u, std::thread::hardware_concurrency());
+    std::vector<unsigned> counts;
+    for (unsigned t = 1; t <= limit; t *= 2) counts.push_back(t);
+    if (counts.back() != limit) counts.push_back(limit);
+    return counts;
+}
+
+// TEPS (traversed edges per second, Graph500 style) for BFS on an undirected
+// R-MAT graph: the serial queue BFS, then top-down-only and
+// direction-optimizing parallel BFS across thread counts. Each row is the
+// harmonic mean over the same random sources.
+void benchmarkParallelBfs(unsigned scale, size_t sources, unsigned maxThreads) {
+    printSeparator("BENCHMARK: DIRECTION-OPTIMIZING PARALLEL BFS");
+    using Csr = CsrGraph<int>;
+    
+    auto start = BenchClock::now();
+    auto edges = generateRmatEdges(scale, 16, 1);
+    std::cout << "R-MAT scale " << scale << ": " << (size_t(1) << scale) << " vertices, "
+              << edges.size() << " undirected edges (" << std::fixed << std::setprecision(0)
+              << millisecondsSince(start) << " ms)" << std::endl;
+    start = BenchClock::now();
+    size_t before = heapBytesInUse();
+    Csr csr = Csr::fromEdgeList(size_t(1) << scale, edges, true);
+    std::cout << "CSR built in " << millisecondsSince(start) << " ms, "
+              << formatMegabytes(heapBytesInUse() - before) << std::endl;
+    edges.clear();
+    edges.shrink_to_fit();
+    
+    // Sources with at least one edge; per-source edge count for TEPS is the
+    // number of input edges inside the reached component
+    std::mt19937_64 rng(3);
+    std::vector<Csr::VertexId> roots;
+    std::vector<double> componentEdges;
+    while (roots.size() < sources) {
+        auto v = static_cast<Csr::VertexId>(rng() % csr.vertexCount());
+        if (csr.degree(v) == 0) continue;
+        size_t degreeSum = 0;
+        for (auto u : csr.bfs(v)) degreeSum += csr.degree(u);
+        roots.push_back(v);
+        componentEdges.push_back(degreeSum / 2.0);
+    }
+    
+    struct Row {
+        std::string mode;
+        unsigned threads;
+        double meanMs;
+        double teps;
+        std::string steps;
+    };
+    std::vector<Row> rows;
+    auto harmonicTeps = [&](const std::vector<double>& seconds) {
+        double inverse = 0;
+        for (size_t i = 0; i < seconds.size(); ++i) inverse += seconds[i] / componentEdges[i];
+        return seconds.size() / inverse;
+    };
+    
+    std::vector<double> seconds;
+    for (auto root : roots) {
+        auto begin = BenchClock::now();
+        csr.bfs(root);
+        seconds.push_back(millisecondsSince(begin) / 1000.0);
+    }
+    double total = 0;
+    for (double t : seconds) total += t;
+    rows.push_back({"serial queue BFS", 1, total * 1000.0 / roots.size(), harmonicTeps(seconds), "-"});
+    
+    bool valid = true;
+    for (unsigned threads : benchmarkThreadCounts(maxThreads)) {
+        ForkJoinPool pool(threads);
+        for (bool optimizing : {false, true}) {
+            Csr::BfsOptions options;
+            options.directionOptimizing = optimizing;
+            seconds.clear();
+            size_t topDown = 0;
+            size_t bottomUp = 0;
+            for (size_t i = 0; i < roots.size(); ++i) {
+                auto begin = BenchClock::now();
+                auto tree = csr.parallelBfs(roots[i], pool, nullptr, options);
+                seconds.push_back(millisecondsSince(begin) / 1000.0);
+                topDown += tree.topDownSteps;
+                bottomUp += tree.bottomUpSteps;
+                
+                if (i == 0) {
+                    // Every tree edge goes down one level, no edge spans more than one
+                    for (Csr::VertexId v = 0; v < csr.vertexCount() && valid; ++v) {
+                        if (tree.level[v] < 0) continue;
+                        if (v != roots[i] && tree.level[tree.parent[v]] + 1 != tree.level[v]) valid = false;
+                        for (size_t e = csr.edgesBegin(v); e < csr.edgesEnd(v); ++e) {
+                            if (std::abs(tree.level[csr.target(e)] - tree.level[v]) > 1) valid = false;
+                        }
+                    }
+                }
+            }
+            total = 0;
+            for (double t : seconds) total += t;
+            rows.push_back({optimizing ? "direction-optimizing" : "top-down only", threads,
+                            total * 1000.0 / roots.size(), harmonicTeps(seconds),
+                            std::to_string(topDown / roots.size()) + " TD / " +
+                            std::to_string(bottomUp / roots.size()) + " BU"});
+        }
+    }
+    
+    std::cout << "\n" << std::left << std::setw(22) << "mode" << std::right << std::setw(8) << "threads"
+              << std::setw(12) << "mean ms" << std::setw(14) << "MTEPS" << std::setw(18) << "steps/search" << std::endl;
+    for (const auto& row : rows) {
+        std::cout << std::left << std::setw(22) << row.mode << std::right << std::setw(8) << row.threads
+                  << std::fixed << std::setprecision(1) << std::setw(12) << row.meanMs
+                  << std::setw(14) << row.teps / 1e6 << std::setw(18) << row.steps << std::endl;
+    }
+    std::cout << "\nBFS trees valid (parent one level up, no edge skips a level): " << (valid ? "Yes" : "No") << std::endl;
+    std::cout << "Hardware threads: " << std::thread::hardware_concurrency()
+              << "; counts above that time-slice rather than scale." << std::endl;
+}
+
+// Sequential union-find with union by size and path halving
+class SequentialUnionFind {
+public:
+    explicit SequentialUnionFind(size_t n) : parent_(n), size_(n, 1) {
+        for (size_t v = 0; v < n; ++v) parent_[v] = static_cast<uint32_t>(v);
+    }
+    
+    uint32_t find(uint32_t v) {
+        while (parent_[v] != v) {
+            parent_[v] = parent_[parent_[v]];
+            v = parent_[v];
+        }
+        return v;
+    }
+    
+    bool unite(uint32_t a, uint32_t b) {
+        a = find(a);
+        b = find(b);
+        if (a == b) return false;
+        if (size_[a] < size_[b]) std::swap(a, b);
+        parent_[b] = a;
+        size_[a] += size_[b];
+        return true;
+    }
+    
+private:
+    std::vector<uint32_t> parent_;
+    std::vector<uint32_t> size_;
+};
+
+// Kruskal: sort every undirected edge once, add it if it joins two trees
+int64_t kruskalForestWeight(const CsrGraph<int>& csr, size_t& treeEdges) {
+    std::vector<CsrGraph<int>::WeightedEdge> edges;
+    edges.reserve(csr.edgeCount() / 2);
+    for (CsrGraph<int>::VertexId v = 0; v < csr.vertexCount(); ++v) {
+        for (size_t e = csr.edgesBegin(v); e < csr.edgesEnd(v); ++e) {
+            if (v < csr.target(e)) edges.push_back({v, csr.target(e), csr.weight(e)});
+        }
+    }
+    std::sort(edges.begin(), edges.end(), [](const auto& a, const auto& b) { return a.weight < b.weight; });
+    
+    SequentialUnionFind sets(csr.vertexCount());
+    int64_t total = 0;
+    treeEdges = 0;
+    for (const auto& edge : edges) {
+        if (sets.unite(edge.from, edge.to)) {
+            total += edge.weight;
+            ++treeEdges;
+        }
+    }
+    return total;
+}
+
+// Parallel Boruvka MST and Afforest components on an undirected R-MAT graph
+// against sequential Kruskal and a sequential union-find pass over all edges
+void benchmarkSpanningForest(unsigned scale, unsigned maxThreads) {
+    printSeparator("BENCHMARK: PARALLEL MST AND CONNECTED COMPONENTS");
+    using Csr = CsrGraph<int>;
+    
+    auto start = BenchClock::now();
+    auto edgeList = generateRmatEdges(scale, 16, 2);
+    Csr csr = Csr::fromEdgeList(size_t(1) << scale, edgeList, true);
+    edgeList.clear();
+    edgeList.shrink_to_fit();
+    std::cout << "R-MAT scale " << scale << ": " << csr.vertexCount() << " vertices, " << csr.edgeCount() / 2
+              << " undirected edges (" << std::fixed << std::setprecision(0) << millisecondsSince(start)
+              << " ms to generate)" << std::endl;
+    
+    start = BenchClock::now();
+    size_t kruskalEdges = 0;
+    int64_t kruskalWeight = kruskalForestWeight(csr, kruskalEdges);
+    double kruskalMs = millisecondsSince(start);
+    
+    start = BenchClock::now();
+    SequentialUnionFind sets(csr.vertexCount());
+    for (Csr::VertexId v = 0; v < csr.vertexCount(); ++v) {
+        for (size_t e = csr.edgesBegin(v); e < csr.edgesEnd(v); ++e) sets.unite(v, csr.target(e));
+    }
+    size_t componentCount = 0;
+    for (Csr::VertexId v = 0; v < csr.vertexCount(); ++v) componentCount += sets.find(v) == v;
+    double unionFindMs = millisecondsSince(start);
+    std::cout << "Kruskal: " << kruskalMs << " ms, forest weight " << kruskalWeight << " over " << kruskalEdges
+              << " edges; sequential union-find: " << unionFindMs << " ms, " << componentCount << " components" << std::endl;
+    
+    struct Row {
+        unsigned threads;
+        double boruvkaMs;
+        size_t rounds;
+        double componentsMs;
+        bool correct;
+    };
+    std::vector<Row> rows;
+    for (unsigned threads : benchmarkThreadCounts(maxThreads ? maxThreads : 32)) {
+        ForkJoinPool pool(threads);
+        start = BenchClock::now();
+        auto forest = csr.minimumSpanningForest(pool);
+        double boruvkaMs = millisecondsSince(start);
+        
+        start = BenchClock::now();
+        auto component = csr.connectedComponents(pool);
+        double componentsMs = millisecondsSince(start);
+        
+        // Same weight and size as Kruskal; labels consistent on every edge and
+        // as many distinct labels as the sequential pass found
+        bool correct = forest.totalWeight == kruskalWeight && forest.edges.size() == kruskalEdges;
+        size_t roots = 0;
+        for (Csr::VertexId v = 0; v < csr.vertexCount() && correct; ++v) {
+            roots += component[v] == v;
+            correct = forest.component[v] == component[v];
+            for (size_t e = csr.edgesBegin(v); e < csr.edgesEnd(v) && correct; ++e) {
+                correct = component[csr.target(e)] == component[v];
+            }
+        }
+        rows.push_back({threads, boruvkaMs, forest.rounds, componentsMs, correct && roots == componentCount});
+    }
+    
+    std::cout << "\n" << std::setw(8) << "threads" << std::setw(14) << "Boruvka ms" << std::setw(10) << "rounds"
+              << std::setw(12) << "vs Kruskal" << std::setw(16) << "components ms" << std::setw(14) << "vs seq UF"
+              << std::setw(10) << "correct" << std::endl;
+    for (const auto& row : rows) {
+        std::cout << std::setw(8) << row.threads << std::fixed << std::setprecision(1)
+                  << std::setw(14) << row.boruvkaMs << std::setw(10) << row.rounds
+                  << std::setw(11) << kruskalMs / row.boruvkaMs << "x"
+                  << std::setw(16) << row.componentsMs << std::setw(13) << unionFindMs / row.componentsMs << "x"
+                  << std::setw(10) << (row.correct ? "yes" : "NO") << std::endl;
+    }
+    std::cout << "\nHardware threads: " << std::thread::hardware_concurrency()
+              << "; counts above that time-slice rather than scale." << std::endl;
+}
+
+// Dependency stream over a hidden random ranking: every edge points forward
+// in rank, except one in a hundred that is reversed and may close a cycle.
+// Uniform picks both ends at random; local picks the target a few ranks
+// after the source, like tasks depending on recent tasks.
+std::vector<std::pair<int, int>> generateDependencyStream(size_t vertices, size_t insertions, bool local, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::vector<int> rank(vertices);
+    for (size_t v = 0; v < vertices; ++v) rank[v] = static_cast<int>(v);
+    std::shuffle(rank.begin(), rank.end(), rng);
+    std::vector<int> byRank(vertices);
+    for (size_t v = 0; v < vertices; ++v) byRank[rank[v]] = static_cast<int>(v);
+    
+    std::uniform_int_distribution<size_t> pick(0, vertices - 1);
+    std::geometric_distribution<size_t> gap(1.0 / 32);
+    std::vector<std::pair<int, int>> stream;
+    stream.reserve(insertions);
+    while (stream.size() < insertions) {
+        size_t from = pick(rng), to;
+        if (local) {
+            to = from + 1 + gap(rng);
+            if (to >= vertices) continue;
+        } else {
+            to = pick(rng);
+            if (from == to) continue;
+            if (from > to) std::swap(from, to);
+        }
+        if (rng() % 100 == 0) std::swap(from, to);
+        stream.emplace_back(byRank[from], byRank[to]);
+    }
+    return stream;
+}
+
+void benchmarkIncrementalTopologicalOrder(size_t insertions, size_t vertices) {
+    printSeparator("BENCHMARK: INCREMENTAL TOPOLOGICAL ORDER");
+    vertices = std::max<size_t>(vertices, 2);
+    std::cout << insertions << " edge insertions over " << vertices << " vertices. Recompute-each-time runs"
+              << " topologicalSort() at 10 checkpoints and integrates the per-call cost." << std::endl;
+    
+    struct Row {
+        const char* workload;
+        size_t rejected;
+        double plainMs;
+        double maintainedMs;
+        double recomputeLastMs;
+        double recomputeTotalMs;
+        bool valid;
+    };
+    std::vector<Row> rows;
+    for (bool local : {false, true}) {
+        auto stream = generateDependencyStream(vertices, insertions, local, 11);
+        Graph<int> maintained(true), plain(true);
+        maintained.setVerbose(false);
+        plain.setVerbose(false);
+        for (size_t v = 0; v < vertices; ++v) {
+            maintained.addVertex(static_cast<int>(v));
+            plain.addVertex(static_cast<int>(v));
+        }
+        maintained.maintainTopologicalOrder();
+        
+        // Rejections print a line each; keep them out of the timing output
+        std::vector<char> accepted(stream.size());
+        std::streambuf* console = std::cout.rdbuf(nullptr);
+        auto start = BenchClock::now();
+        for (size_t i = 0; i < stream.size(); ++i) {
+            accepted[i] = maintained.addEdge(stream[i].first, stream[i].second);
+        }
+        double maintainedMs = millisecondsSince(start);
+        std::cout.rdbuf(console);
+        
+        // The plain graph gets the accepted edges only, so it stays a DAG
+        // and each recompute does the full sort
+        const size_t checkpoints = 10;
+        double plainMs = 0, recomputeLastMs = 0, recomputeTotalMs = 0, previousCallMs = 0;
+        size_t done = 0;
+        for (size_t c = 1; c <= checkpoints; ++c) {
+            size_t until = stream.size() * c / checkpoints;
+            start = BenchClock::now();
+            for (; done < until; ++done) {
+                if (accepted[done]) plain.addEdge(stream[done].first, stream[done].second);
+            }
+            plainMs += millisecondsSince(start);
+            
+            start = BenchClock::now();
+            auto order = plain.topologicalSort();
+            recomputeLastMs = millisecondsSince(start);
+            recomputeTotalMs += (previousCallMs + recomputeLastMs) / 2 * (stream.size() / checkpoints);
+            previousCallMs = recomputeLastMs;
+        }
+        
+        // Every accepted edge must point forward in the maintained order
+        bool valid = maintained.topologicalOrder()->vertexCount() == vertices;
+        size_t rejected = 0;
+        for (size_t i = 0; i < stream.size(); ++i) {
+            if (!accepted[i]) {
+                ++rejected;
+            } else if (!maintained.topologicalOrder()->precedes(stream[i].first, stream[i].second)) {
+                valid = false;
+            }
+        }
+        rows.push_back({local ? "local" : "uniform", rejected, plainMs, maintainedMs,
+                        recomputeLastMs, recomputeTotalMs, valid});
+    }
+    
+    std::cout << "\n" << std::left << std::setw(10) << "workload" << std::right << std::setw(10) << "rejected"
+              << std::setw(14) << "addEdge ms" << std::setw(16) << "maintained ms" << std::setw(12) << "us/insert"
+              << std::setw(14) << "1 resort ms" << std::setw(16) << "recompute est" << std::setw(10) << "speedup"
+              << std::setw(8) << "valid" << std::endl;
+    for (const auto& row : rows) {
+        std::cout << std::left << std::setw(10) << row.workload << std::right << std::setw(10) << row.rejected
+                  << std::fixed << std::setprecision(1) << std::setw(14) << row.plainMs
+                  << std::setw(16) << row.maintainedMs
+                  << std::setprecision(2) << std::setw(12) << row.maintainedMs * 1000 / insertions
+                  << std::setprecision(1) << std::setw(14) << row.recomputeLastMs
+                  << std::setw(14) << row.recomputeTotalMs / 3.6e6 << " h"
+                  << std::setprecision(0) << std::setw(9) << row.recomputeTotalMs / row.maintainedMs << "x"
+                  << std::setw(8) << (row.valid ? "yes" : "NO") << std::endl;
+    }
+    std::cout << "\naddEdge ms is the plain graph taking the same accepted edges with no order kept;"
+              << "\n1 resort ms is one topologicalSort() on the final graph." << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    std::string bench;
+    size_t benchEdges = 10000000;
+    size_t benchVertices = 1000000;
+    size_t benchQueries = 20;
+    unsigned benchScale = 20;
+    size_t benchSources = 8;
+    unsigned benchThreads = 0;
+    size_t benchInsertions = 1000000;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--bench-csr") {
+            bench = "csr";
+        } else if (arg == "--bench-dijkstra") {
+            bench = "dijkstra";
+        } else if (arg == "--bench-mst") {
+            bench = "mst";
+        } else if (arg == "--bench-routing") {
+            bench = "routing";
+        } else if (arg == "--bench-bfs") {
+            bench = "bfs";
+        } else if (arg == "--bench-topo") {
+            bench = "topo";
+        } else if (arg == "--insertions" && i + 1 < argc) {
+            benchInsertions = std::stoull(argv[++i]);
+        } else if (arg == "--scale" && i + 1 < argc) {
+            benchScale = static_cast<unsigned>(std::stoul(argv[++i]));
+        } else if (arg == "--sources" && i + 1 < argc) {
+            benchSources = std::max<size_t>(std::stoull(argv[++i]), 1);
+        } else if (arg == "--threads" && i + 1 < argc) {
+            benchThreads = static_cast<unsigned>(std::stoul(argv[++i]));
+        } else if (arg == "--edges" && i + 1 < argc) {
+            benchEdges = std::stoull(argv[++i]);
+        } else if (arg == "--vertices" && i + 1 < argc) {
+            benchVertices = std::stoull(argv[++i]);
+        } else if (arg == "--queries" && i + 1 < argc) {
+            benchQueries = std::max<size_t>(std::stoull(argv[++i]), 1);
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--bench-csr [--edges N]]"
+                      << " [--bench-dijkstra [--vertices N] [--queries N]]"
+                      << " [--bench-bfs [--scale S] [--sources N] [--threads MAX]]"
+                      << " [--bench-routing [--vertices N] [--queries N]]"
+                      << " [--bench-mst [--scale S] [--threads MAX]]"
+                      << " [--bench-topo [--insertions N] [--vertices N]]" << std::endl;
+            return 1;
+        }
+    }
+    
+    if (!bench.empty()) {
+        try {
+            if (bench == "csr") benchmarkCsrLayout(benchEdges);
+            if (bench == "dijkstra") benchmarkDijkstraQueues(benchVertices, benchQueries);
+            if (bench == "bfs") benchmarkParallelBfs(benchScale, benchSources, benchThreads);
+            if (bench == "routing") benchmarkRouting(benchVertices, benchQueries);
+            if (bench == "mst") benchmarkSpanningForest(benchScale, benchThreads);
+            if (bench == "topo") benchmarkIncrementalTopologicalOrder(benchInsertions, benchVertices);
+        } catch (const std::exception& e) {
+            std::cerr << "An error occurred: " << e.what() << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+    
     std::cout << "===============================================" << std::endl;
     std::cout << "         GRAPH DEMONSTRATION                 " << std::endl;
     std::cout << "===============================================" << std::endl;
@@ -940,6 +3557,11 @@ int main() {
         demonstratePracticalApplications();
         demonstrateGraphTypes();
         demonstratePerformanceCharacteristics();
+        demonstrateFrozenGraph();
+        demonstrateParallelBfs();
+        demonstrateRouting();
+        demonstrateSpanningTreeAndComponents();
+        demonstrateIncrementalTopologicalOrder();
         
         printSeparator("COMPREHENSIVE SUMMARY");
         
@@ -37,6 +37,81 @@ Educational Demonstrations:
 #include <memory>
 #include <algorithm>
 #include <iomanip>
+#include <sstream>
+#include <limits>
+#include <new>
+#include <cstdint>
+#include <chrono>
+#include <unordered_map>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Bucket array in fixed-size chunks that are allocated on first use and
+// can be freed from the front. A table can then build its next array and
+// drop the old one a chunk at a time, instead of constructing or freeing
+// millions of buckets in a single step.
+template<typename Bucket>
+class ChunkedBuckets {
+public:
+    ChunkedBuckets() = default;
+    explicit ChunkedBuckets(size_t count) {
+        while ((size_t(1) << chunkBits_) < count && chunkBits_ < MAX_CHUNK_BITS) ++chunkBits_;
+        chunks_.resize((count + chunkSize() - 1) >> chunkBits_);
+    }
+    
+    // Deep copy: allocated chunks are copied, unallocated ones stay unallocated
+    ChunkedBuckets(const ChunkedBuckets& other)
+        : chunks_(other.chunks_.size()), chunkBits_(other.chunkBits_), released_(other.released_) {
+        for (size_t c = 0; c < chunks_.size(); ++c) {
+            if (!other.chunks_[c]) continue;
+            chunks_[c].reset(new Bucket[chunkSize()]);
+            std::copy(other.chunks_[c].get(), other.chunks_[c].get() + chunkSize(), chunks_[c].get());
+        }
+    }
+    
+    ChunkedBuckets& operator=(const ChunkedBuckets& other) {
+        if (this != &other) *this = ChunkedBuckets(other);
+        return *this;
+    }
+    
+    ChunkedBuckets(ChunkedBuckets&&) noexcept = default;
+    ChunkedBuckets& operator=(ChunkedBuckets&&) noexcept = default;
+    
+    Bucket& at(size_t index) {
+        auto& chunk = chunks_[index >> chunkBits_];
+        if (!chunk) chunk.reset(new Bucket[chunkSize()]);
+        return chunk[index & (chunkSize() - 1)];
+    }
+    
+    // nullptr when the bucket's chunk was never allocated (so it is empty)
+    Bucket* find(size_t index) {
+        auto& chunk = chunks_[index >> chunkBits_];
+        return chunk ? &chunk[index & (chunkSize() - 1)] : nullptr;
+    }
+    
+    const Bucket* find(size_t index) const {
+        const auto& chunk = chunks_[index >> chunkBits_];
+        return chunk ? &chunk[index & (chunkSize() - 1)] : nullptr;
+    }
+    
+    // Free every chunk that lies wholly below index
+    void releaseBelow(size_t index) {
+        for (size_t c = index >> chunkBits_; released_ < c; ++released_) chunks_[released_].reset();
+    }
+    
+private:
+    static constexpr size_t MAX_CHUNK_BITS = 8; // 256 buckets per chunk
+    
+    size_t chunkSize() const { return size_t(1) << chunkBits_; }
+    
+    std::vector<std::unique_ptr<Bucket[]>> chunks_;
+    size_t chunkBits_ = 0;
+    size_t released_ = 0;
+};
 
 // Hash Table with Separate Chaining
 template<typename K, typename V>
@@ -54,72 +129,165 @@ private:
     static constexpr double MAX_LOAD_FACTOR = 0.75;
     static constexpr double MIN_LOAD_FACTOR = 0.25;
     
-    std::vector<std::list<KeyValue>> table_;
+    using Bucket = std::list<KeyValue>;
+    
+    // Old buckets moved per insert or remove while an incremental resize
+    // runs. A doubling finishes after oldCapacity / 4 operations, well
+    // before the new array reaches its own load limit.
+    static constexpr size_t MIGRATE_BUCKETS = 4;
+    
+    ChunkedBuckets<Bucket> table_;
     size_t size_;
     size_t capacity_;
     std::hash<K> hasher_;
+    bool verbose_ = true;
+    
+    // Incremental resize: while oldCapacity_ != 0, old buckets below
+    // migrateNext_ have been moved into table_ and the rest still hold
+    // their keys, so every key lives in exactly one of the two arrays
+    bool incremental_ = false;
+    ChunkedBuckets<Bucket> oldTable_;
+    size_t oldCapacity_ = 0;
+    size_t migrateNext_ = 0;
     
     // Hash function
     size_t hash(const K& key) const {
         return hasher_(key) % capacity_;
     }
     
+    bool migrating() const { return oldCapacity_ != 0; }
+    
+    // The bucket that holds (or would hold) key, in whichever array owns it
+    Bucket& bucketFor(const K& key) {
+        size_t h = hasher_(key);
+        if (migrating() && h % oldCapacity_ >= migrateNext_) return oldTable_.at(h % oldCapacity_);
+        return table_.at(h % capacity_);
+    }
+    
+    const Bucket* findBucket(const K& key) const {
+        size_t h = hasher_(key);
+        if (migrating() && h % oldCapacity_ >= migrateNext_) return oldTable_.find(h % oldCapacity_);
+        return table_.find(h % capacity_);
+    }
+    
     // Resize the table
     void resize(size_t newCapacity) {
-        std::cout << "Resizing hash table from " << capacity_ << " to " << newCapacity << std::endl;
+        if (incremental_) {
+            startIncrementalResize(newCapacity);
+            return;
+        }
+        if (verbose_) std::cout << "Resizing hash table from " << capacity_ << " to " << newCapacity << std::endl;
         
-        std::vector<std::list<KeyValue>> oldTable = std::move(table_);
+        ChunkedBuckets<Bucket> oldTable = std::move(table_);
         size_t oldCapacity = capacity_;
         
         capacity_ = newCapacity;
-        table_.clear();
-        table_.resize(capacity_);
+        table_ = ChunkedBuckets<Bucket>(capacity_);
         size_t oldSize = size_;
         size_ = 0;
         
         // Rehash all elements
-        for (const auto& bucket : oldTable) {
-            for (const auto& kv : bucket) {
-                insertInternal(kv.key, kv.value);
+        for (size_t i = 0; i < oldCapacity; ++i) {
+            if (const Bucket* bucket = oldTable.find(i)) {
+                for (const auto& kv : *bucket) {
+                    insertInternal(kv.key, kv.value);
+                }
             }
         }
         
-        std::cout << "Rehashed " << oldSize << " elements" << std::endl;
+        if (verbose_) std::cout << "Rehashed " << oldSize << " elements" << std::endl;
+    }
+    
+    // Keep the current array as the old one and start an empty new one;
+    // its chunks are allocated as buckets are moved into them
+    void startIncrementalResize(size_t newCapacity) {
+        if (migrating()) finishMigration();
+        if (verbose_) std::cout << "Incremental resize from " << capacity_ << " to " << newCapacity << " started" << std::endl;
+        oldTable_ = std::move(table_);
+        oldCapacity_ = capacity_;
+        migrateNext_ = 0;
+        capacity_ = newCapacity;
+        table_ = ChunkedBuckets<Bucket>(capacity_);
+    }
+    
+    // Move up to count old buckets, relinking the list nodes (no copies),
+    // and free old chunks as they empty
+    void migrate(size_t count) {
+        for (size_t moved = 0; moved < count && migrateNext_ < oldCapacity_; ++moved, ++migrateNext_) {
+            Bucket* bucket = oldTable_.find(migrateNext_);
+            while (bucket && !bucket->empty()) {
+                Bucket& target = table_.at(hash(bucket->front().key));
+                target.splice(target.end(), *bucket, bucket->begin());
+            }
+        }
+        oldTable_.releaseBelow(migrateNext_);
+        
+        if (migrateNext_ == oldCapacity_) {
+            if (verbose_) std::cout << "Incremental resize to " << capacity_ << " finished" << std::endl;
+            oldTable_ = ChunkedBuckets<Bucket>();
+            oldCapacity_ = 0;
+            migrateNext_ = 0;
+        }
+    }
+    
+    void finishMigration() {
+        if (migrating()) migrate(oldCapacity_);
     }
     
     // Internal insert without resize check
     bool insertInternal(const K& key, const V& value) {
-        size_t index = hash(key);
+        Bucket& bucket = bucketFor(key);
         
         // Check if key already exists
-        for (auto& kv : table_[index]) {
+        for (auto& kv : bucket) {
             if (kv.key == key) {
                 kv.value = value; // Update existing value
                 return false; // Key already existed
             }
         }
         
-        table_[index].emplace_back(key, value);
+        bucket.emplace_back(key, value);
         size_++;
         return true; // New key inserted
     }
     
+    // Buckets of both arrays that may hold keys
+    template<typename Visit>
+    void forEachBucket(Visit visit) const {
+        for (size_t i = 0; i < capacity_; ++i) {
+            if (const Bucket* bucket = table_.find(i)) visit(*bucket);
+        }
+        for (size_t i = migrateNext_; i < oldCapacity_; ++i) {
+            if (const Bucket* bucket = oldTable_.find(i)) visit(*bucket);
+        }
+    }
+    
 public:
     // Constructor
     explicit HashTableChaining(size_t capacity = DEFAULT_CAPACITY) 
-        : capacity_(capacity), size_(0) {
-        table_.resize(capacity_);
+        : table_(capacity), size_(0), capacity_(capacity) {}
+    
+    // Grow and shrink by moving a few buckets per insert/remove instead
+    // of rehashing everything at once. search() is const and does not
+    // migrate; it looks in whichever array currently owns the key's bucket.
+    void setIncrementalResize(bool incremental) {
+        if (!incremental) finishMigration();
+        incremental_ = incremental;
     }
     
+    bool isResizing() const { return migrating(); }
+    
     // Insert key-value pair
     void insert(const K& key, const V& value) {
+        if (migrating()) migrate(MIGRATE_BUCKETS);
+        
         // Check if resize is needed
-        if (static_cast<double>(size_) / capacity_ >= MAX_LOAD_FACTOR) {
+        if (!migrating() && static_cast<double>(size_) / capacity_ >= MAX_LOAD_FACTOR) {
             resize(capacity_ * 2);
         }
         
         bool newKey = insertInternal(key, value);
-        std::cout << "Insert " << key << " -> " << value 
+        if (verbose_) std::cout << "Insert " << key << " -> " << value 
                   << (newKey ? " (new)" : " (updated)") 
                   << " | Load factor: " << std::fixed << std::setprecision(3) 
                   << static_cast<double>(size_) / capacity_ << std::endl;
@@ -127,9 +295,10 @@ public:
     
     // Search for a value by key
     std::optional<V> search(const K& key) const {
-        size_t index = hash(key);
+        const Bucket* bucket = findBucket(key);
+        if (!bucket) return std::nullopt;
         
-        for (const auto& kv : table_[index]) {
+        for (const auto& kv : *bucket) {
             if (kv.key == key) {
                 return kv.value;
             }
@@ -140,9 +309,9 @@ public:
     
     // Remove key-value pair
     bool remove(const K& key) {
-        size_t index = hash(key);
+        if (migrating()) migrate(MIGRATE_BUCKETS);
         
-        auto& bucket = table_[index];
+        auto& bucket = bucketFor(key);
         auto it = std::find_if(bucket.begin(), bucket.end(),
                               [&key](const KeyValue& kv) { return kv.key == key; });
         
@@ -151,12 +320,12 @@ public:
             size_--;
             
             // Check if resize down is needed
-            if (capacity_ > DEFAULT_CAPACITY && 
+            if (!migrating() && capacity_ > DEFAULT_CAPACITY && 
                 static_cast<double>(size_) / capacity_ < MIN_LOAD_FACTOR) {
                 resize(capacity_ / 2);
             }
             
-            std::cout << "Removed " << key 
+            if (verbose_) std::cout << "Removed " << key 
                       << " | Load factor: " << std::fixed << std::setprecision(3) 
                       << static_cast<double>(size_) / capacity_ << std::endl;
             return true;
@@ -174,25 +343,28 @@ public:
     // Get all keys
     std::vector<K> keys() const {
         std::vector<K> result;
-        for (const auto& bucket : table_) {
+        forEachBucket([&result](const Bucket& bucket) {
             for (const auto& kv : bucket) {
                 result.push_back(kv.key);
             }
-        }
+        });
         return result;
     }
     
     // Get all values
     std::vector<V> values() const {
         std::vector<V> result;
-        for (const auto& bucket : table_) {
+        forEachBucket([&result](const Bucket& bucket) {
             for (const auto& kv : bucket) {
                 result.push_back(kv.value);
             }
-        }
+        });
         return result;
     }
     
+    // Per-operation logging; turn off for bulk loads and benchmarks
+    void setVerbose(bool verbose) { verbose_ = verbose; }
+    
     // Properties
     size_t size() const { return size_; }
     size_t capacity() const { return capacity_; }
@@ -205,19 +377,26 @@ public:
         std::cout << "Size: " << size_ << std::endl;
         std::cout << "Capacity: " << capacity_ << std::endl;
         std::cout << "Load Factor: " << std::fixed << std::setprecision(3) << loadFactor() << std::endl;
+        if (migrating()) {
+            std::cout << "Resizing: " << migrateNext_ << " of " << oldCapacity_
+                      << " old buckets moved (statistics below cover the new array)" << std::endl;
+        }
         
         // Calculate collision statistics
         size_t emptyBuckets = 0;
         size_t maxChainLength = 0;
         size_t totalCollisions = 0;
+        size_t stored = 0;
         
-        for (const auto& bucket : table_) {
-            if (bucket.empty()) {
+        for (size_t i = 0; i < capacity_; ++i) {
+            const Bucket* bucket = table_.find(i);
+            if (!bucket || bucket->empty()) {
                 emptyBuckets++;
             } else {
-                maxChainLength = std::max(maxChainLength, bucket.size());
-                if (bucket.size() > 1) {
-                    totalCollisions += bucket.size() - 1;
+                stored += bucket->size();
+                maxChainLength = std::max(maxChainLength, bucket->size());
+                if (bucket->size() > 1) {
+                    totalCollisions += bucket->size() - 1;
                 }
             }
         }
@@ -229,40 +408,58 @@ public:
         std::cout << "Total Collisions: " << totalCollisions << std::endl;
         std::cout << "Average Chain Length: " 
                   << std::fixed << std::setprecision(2)
-                  << static_cast<double>(size_) / (capacity_ - emptyBuckets) << std::endl;
+                  << static_cast<double>(stored) / (capacity_ - emptyBuckets) << std::endl;
     }
     
     // Display table structure
     void displayTable() const {
-        std::cout << "\nHash Table Structure:" << std::endl;
-        for (size_t i = 0; i < capacity_; ++i) {
-            std::cout << "Bucket " << std::setw(2) << i << ": ";
-            if (table_[i].empty()) {
+        auto showBucket = [](const char* label, size_t index, const Bucket* bucket) {
+            std::cout << label << std::setw(2) << index << ": ";
+            if (!bucket || bucket->empty()) {
                 std::cout << "(empty)";
             } else {
                 bool first = true;
-                for (const auto& kv : table_[i]) {
+                for (const auto& kv : *bucket) {
                     if (!first) std::cout << " -> ";
                     std::cout << "[" << kv.key << ":" << kv.value << "]";
                     first = false;
                 }
             }
             std::cout << std::endl;
+        };
+        
+        std::cout << "\nHash Table Structure:" << std::endl;
+        for (size_t i = 0; i < capacity_; ++i) showBucket("Bucket ", i, table_.find(i));
+        if (migrating()) {
+            std::cout << "Old buckets not yet moved:" << std::endl;
+            for (size_t i = migrateNext_; i < oldCapacity_; ++i) showBucket("Old bucket ", i, oldTable_.find(i));
         }
     }
     
     // Clear all elements
     void clear() {
-        for (auto& bucket : table_) {
-            bucket.clear();
-        }
+        table_ = ChunkedBuckets<Bucket>(capacity_);
+        oldTable_ = ChunkedBuckets<Bucket>();
+        oldCapacity_ = 0;
+        migrateNext_ = 0;
         size_ = 0;
-        std::cout << "Hash table cleared" << std::endl;
+        if (verbose_) std::cout << "Hash table cleared" << std::endl;
     }
 };
 
-// Hash Table with Open Addressing (Linear Probing)
-template<typename K, typename V>
+// How HashTableOpenAddressing resolves collisions.
+// LINEAR: first free slot after the home slot; deletion leaves a DELETED
+// tombstone that lengthens probes until the next resize.
+// ROBIN_HOOD: each entry records its distance from its home slot, and an
+// insert that meets an entry closer to home than itself takes that slot and
+// carries the displaced entry on. Distances stay low and even, a search can
+// stop as soon as it meets an entry closer to home than the probe so far,
+// and deletion shifts the following entries back one slot instead of
+// leaving a tombstone.
+enum class ProbingPolicy { LINEAR, ROBIN_HOOD };
+
+// Hash Table with Open Addressing (Linear Probing or Robin Hood)
+template<typename K, typename V, ProbingPolicy Policy = ProbingPolicy::LINEAR>
 class HashTableOpenAddressing {
 public:
     enum class EntryState { EMPTY, OCCUPIED, DELETED };
@@ -271,9 +468,10 @@ public:
         K key;
         V value;
         EntryState state;
+        uint32_t distance; // Slots past the home slot (kept for both policies)
         
-        Entry() : state(EntryState::EMPTY) {}
-        Entry(const K& k, const V& v) : key(k), value(v), state(EntryState::OCCUPIED) {}
+        Entry() : state(EntryState::EMPTY), distance(0) {}
+        Entry(const K& k, const V& v, uint32_t d = 0) : key(k), value(v), state(EntryState::OCCUPIED), distance(d) {}
     };
     
 private:
@@ -285,12 +483,31 @@ private:
     size_t size_;
     size_t capacity_;
     std::hash<K> hasher_;
+    bool verbose_ = true;
+    size_t deleted_ = 0; // DELETED tombstones (LINEAR only)
     
     // Hash function
     size_t hash(const K& key) const {
         return hasher_(key) % capacity_;
     }
     
+    // Index of key, or capacity_ if absent. Robin Hood stops at the first
+    // entry closer to its home than this probe: key would have taken that
+    // slot on insert.
+    size_t findIndex(const K& key) const {
+        size_t index = hash(key);
+        for (uint32_t distance = 0; distance < capacity_; ++distance) {
+            const Entry& entry = table_[index];
+            if (entry.state == EntryState::EMPTY) break;
+            if constexpr (Policy == ProbingPolicy::ROBIN_HOOD) {
+                if (entry.distance < distance) break;
+            }
+            if (entry.state == EntryState::OCCUPIED && entry.key == key) return index;
+            index = (index + 1) % capacity_;
+        }
+        return capacity_;
+    }
+    
     // Find slot for key (for insertion or search)
     size_t findSlot(const K& key) const {
         size_t index = hash(key);
@@ -314,7 +531,7 @@ private:
     
     // Resize the table
     void resize(size_t newCapacity) {
-        std::cout << "Resizing hash table from " << capacity_ << " to " << newCapacity << std::endl;
+        if (verbose_) std::cout << "Resizing hash table from " << capacity_ << " to " << newCapacity << std::endl;
         
         std::vector<Entry> oldTable = std::move(table_);
         size_t oldCapacity = capacity_;
@@ -324,6 +541,7 @@ private:
         table_.resize(capacity_);
         size_t oldSize = size_;
         size_ = 0;
+        deleted_ = 0;
         
         // Rehash all elements
         for (const auto& entry : oldTable) {
@@ -332,11 +550,14 @@ private:
             }
         }
         
-        std::cout << "Rehashed " << oldSize << " elements" << std::endl;
+        if (verbose_) std::cout << "Rehashed " << oldSize << " elements" << std::endl;
     }
     
     // Internal insert without resize check
     bool insertInternal(const K& key, const V& value) {
+        if constexpr (Policy == ProbingPolicy::ROBIN_HOOD) {
+            return insertRobinHood(key, value);
+        }
         size_t index = findSlot(key);
         
         if (table_[index].state == EntryState::OCCUPIED && table_[index].key == key) {
@@ -344,11 +565,49 @@ private:
             return false;
         }
         
-        table_[index] = Entry(key, value);
+        table_[index] = Entry(key, value, static_cast<uint32_t>((index + capacity_ - hash(key)) % capacity_));
         size_++;
         return true;
     }
     
+    // Walk from the home slot; the first entry closer to home than the one
+    // being placed gives up its slot and is carried on. Past that point the
+    // key cannot be in the table, so only the first stretch checks for it.
+    bool insertRobinHood(const K& key, const V& value) {
+        size_t index = hash(key);
+        Entry carried(key, value, 0);
+        bool displaced = false;
+        while (table_[index].state == EntryState::OCCUPIED) {
+            Entry& entry = table_[index];
+            if (!displaced && entry.key == key) {
+                entry.value = value;
+                return false;
+            }
+            if (entry.distance < carried.distance) {
+                std::swap(entry, carried);
+                displaced = true;
+            }
+            index = (index + 1) % capacity_;
+            ++carried.distance;
+        }
+        table_[index] = std::move(carried);
+        size_++;
+        return true;
+    }
+    
+    // Backward-shift deletion: pull each following entry that is not at its
+    // home one slot back, until an empty slot or an entry at home
+    void eraseRobinHood(size_t index) {
+        size_t next = (index + 1) % capacity_;
+        while (table_[next].state == EntryState::OCCUPIED && table_[next].distance > 0) {
+            table_[index] = std::move(table_[next]);
+            --table_[index].distance;
+            index = next;
+            next = (next + 1) % capacity_;
+        }
+        table_[index].state = EntryState::EMPTY;
+    }
+    
 public:
     // Constructor
     explicit HashTableOpenAddressing(size_t capacity = DEFAULT_CAPACITY) 
@@ -358,13 +617,15 @@ public:
     
     // Insert key-value pair
     void insert(const K& key, const V& value) {
-        // Check if resize is needed
-        if (static_cast<double>(size_) / capacity_ >= MAX_LOAD_FACTOR) {
-            resize(capacity_ * 2);
+        // Check if resize is needed. Tombstones count: they are never reused,
+        // so under steady insert/erase churn they would otherwise fill every
+        // empty slot. Mostly tombstones rehashes at the same capacity.
+        if (static_cast<double>(size_ + deleted_) / capacity_ >= MAX_LOAD_FACTOR) {
+            resize(static_cast<double>(size_) / capacity_ >= MAX_LOAD_FACTOR / 2 ? capacity_ * 2 : capacity_);
         }
         
         bool newKey = insertInternal(key, value);
-        std::cout << "Insert " << key << " -> " << value 
+        if (verbose_) std::cout << "Insert " << key << " -> " << value 
                   << (newKey ? " (new)" : " (updated)") 
                   << " | Load factor: " << std::fixed << std::setprecision(3) 
                   << static_cast<double>(size_) / capacity_ << std::endl;
@@ -372,55 +633,37 @@ public:
     
     // Search for a value by key
     std::optional<V> search(const K& key) const {
-        size_t index = hash(key);
-        size_t originalIndex = index;
-        
-        while (table_[index].state != EntryState::EMPTY) {
-            if (table_[index].state == EntryState::OCCUPIED && table_[index].key == key) {
-                return table_[index].value;
-            }
-            
-            index = (index + 1) % capacity_;
-            
-            if (index == originalIndex) {
-                break;
-            }
-        }
-        
-        return std::nullopt;
+        size_t index = findIndex(key);
+        if (index == capacity_) return std::nullopt;
+        return table_[index].value;
     }
     
     // Remove key-value pair
     bool remove(const K& key) {
-        size_t index = hash(key);
-        size_t originalIndex = index;
+        size_t index = findIndex(key);
+        if (index == capacity_) {
+            std::cout << "Key " << key << " not found for removal" << std::endl;
+            return false;
+        }
         
-        while (table_[index].state != EntryState::EMPTY) {
-            if (table_[index].state == EntryState::OCCUPIED && table_[index].key == key) {
-                table_[index].state = EntryState::DELETED;
-                size_--;
-                
-                // Check if resize down is needed
-                if (capacity_ > DEFAULT_CAPACITY && 
-                    static_cast<double>(size_) / capacity_ < MIN_LOAD_FACTOR) {
-                    resize(capacity_ / 2);
-                }
-                
-                std::cout << "Removed " << key 
-                          << " | Load factor: " << std::fixed << std::setprecision(3) 
-                          << static_cast<double>(size_) / capacity_ << std::endl;
-                return true;
-            }
-            
-            index = (index + 1) % capacity_;
-            
-            if (index == originalIndex) {
-                break;
-            }
+        if constexpr (Policy == ProbingPolicy::ROBIN_HOOD) {
+            eraseRobinHood(index);
+        } else {
+            table_[index].state = EntryState::DELETED;
+            deleted_++;
         }
+        size_--;
         
-        std::cout << "Key " << key << " not found for removal" << std::endl;
-        return false;
+        // Check if resize down is needed
+        if (capacity_ > DEFAULT_CAPACITY && 
+            static_cast<double>(size_) / capacity_ < MIN_LOAD_FACTOR) {
+            resize(capacity_ / 2);
+        }
+        
+        if (verbose_) std::cout << "Removed " << key 
+                  << " | Load factor: " << std::fixed << std::setprecision(3) 
+                  << static_cast<double>(size_) / capacity_ << std::endl;
+        return true;
     }
     
     // Check if key exists
@@ -450,15 +693,20 @@ public:
         return result;
     }
     
+    // Per-operation logging; turn off for bulk loads and benchmarks
+    void setVerbose(bool verbose) { verbose_ = verbose; }
+    
     // Properties
     size_t size() const { return size_; }
     size_t capacity() const { return capacity_; }
     bool empty() const { return size_ == 0; }
     double loadFactor() const { return static_cast<double>(size_) / capacity_; }
+    size_t tombstones() const { return deleted_; }
     
     // Statistics
     void printStatistics() const {
-        std::cout << "\nHash Table Statistics (Open Addressing):" << std::endl;
+        std::cout << "\nHash Table Statistics (Open Addressing"
+                  << (Policy == ProbingPolicy::ROBIN_HOOD ? ", Robin Hood" : "") << "):" << std::endl;
         std::cout << "Size: " << size_ << std::endl;
         std::cout << "Capacity: " << capacity_ << std::endl;
         std::cout << "Load Factor: " << std::fixed << std::setprecision(3) << loadFactor() << std::endl;
@@ -486,6 +734,44 @@ public:
         std::cout << "Empty Slots: " << emptySlots << std::endl;
         std::cout << "Utilization: " << std::fixed << std::setprecision(1)
                   << (100.0 * occupiedSlots / capacity_) << "%" << std::endl;
+        
+        auto distances = probeDistances();
+        size_t total = 0;
+        for (size_t d = 0; d < distances.size(); ++d) total += d * distances[d];
+        std::cout << "Average Probe Distance: " << std::setprecision(2)
+                  << (size_ ? static_cast<double>(total) / size_ : 0.0) << std::endl;
+        std::cout << "Max Probe Distance: " << (distances.empty() ? 0 : distances.size() - 1) << std::endl;
+        std::cout << "Average Miss Probes: " << averageMissProbes() << std::endl;
+    }
+    
+    // distances[d] = live entries stored d slots past their home slot; a
+    // successful search for such a key reads d + 1 slots
+    std::vector<size_t> probeDistances() const {
+        std::vector<size_t> distances;
+        for (const auto& entry : table_) {
+            if (entry.state != EntryState::OCCUPIED) continue;
+            if (entry.distance >= distances.size()) distances.resize(entry.distance + 1);
+            distances[entry.distance]++;
+        }
+        return distances;
+    }
+    
+    // Slots an unsuccessful search reads, averaged over every home slot
+    double averageMissProbes() const {
+        size_t total = 0;
+        for (size_t home = 0; home < capacity_; ++home) {
+            size_t index = home;
+            uint32_t distance = 0;
+            while (distance < capacity_ && table_[index].state != EntryState::EMPTY) {
+                if constexpr (Policy == ProbingPolicy::ROBIN_HOOD) {
+                    if (table_[index].distance < distance) break;
+                }
+                index = (index + 1) % capacity_;
+                ++distance;
+            }
+            total += distance + 1;
+        }
+        return static_cast<double>(total) / capacity_;
     }
     
     // Display table structure
@@ -503,6 +789,7 @@ public:
                     break;
                 case EntryState::OCCUPIED:
                     std::cout << "[" << table_[i].key << ":" << table_[i].value << "]";
+                    if (table_[i].distance > 0) std::cout << " +" << table_[i].distance;
                     break;
             }
             std::cout << std::endl;
@@ -515,8 +802,323 @@ public:
             entry.state = EntryState::EMPTY;
         }
         size_ = 0;
-        std::cout << "Hash table cleared" << std::endl;
+        deleted_ = 0;
+        if (verbose_) std::cout << "Hash table cleared" << std::endl;
+    }
+};
+
+// One probe step of FlatHashMap: 16 control bytes tested at once. Every
+// result is a bit mask with bit i standing for slot i of the group. With
+// SSE2 a match is one compare and one movemask; other targets loop.
+class ControlGroup {
+public:
+    static constexpr size_t WIDTH = 16;
+    static constexpr int8_t EMPTY = -128;   // 0b10000000
+    static constexpr int8_t DELETED = -2;   // 0b11111110; full slots hold 0..127
+    
+    explicit ControlGroup(const int8_t* control) {
+#if defined(__SSE2__)
+        bytes_ = _mm_loadu_si128(reinterpret_cast<const __m128i*>(control));
+#else
+        std::copy(control, control + WIDTH, bytes_);
+#endif
+    }
+    
+    // Slots whose control byte equals tag (an H2 value, EMPTY or DELETED)
+    uint32_t match(int8_t tag) const {
+#if defined(__SSE2__)
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(tag), bytes_)));
+#else
+        uint32_t mask = 0;
+        for (size_t i = 0; i < WIDTH; ++i) mask |= uint32_t(bytes_[i] == tag) << i;
+        return mask;
+#endif
+    }
+    
+    uint32_t matchEmpty() const { return match(EMPTY); }
+    
+    // EMPTY and DELETED are the only control bytes with the sign bit set
+    uint32_t matchEmptyOrDeleted() const {
+#if defined(__SSE2__)
+        return static_cast<uint32_t>(_mm_movemask_epi8(bytes_));
+#else
+        uint32_t mask = 0;
+        for (size_t i = 0; i < WIDTH; ++i) mask |= uint32_t(bytes_[i] < 0) << i;
+        return mask;
+#endif
+    }
+    
+private:
+#if defined(__SSE2__)
+    __m128i bytes_;
+#else
+    int8_t bytes_[WIDTH];
+#endif
+};
+
+inline unsigned lowestSetBit(uint32_t mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctz(mask));
+#else
+    unsigned bit = 0;
+    while (!(mask & 1)) { mask >>= 1; ++bit; }
+    return bit;
+#endif
+}
+
+// Swiss-table style open addressing. Keys and values live in a flat slot
+// array; a separate array holds one control byte per slot: EMPTY, DELETED,
+// or the low 7 bits of the key's hash (H2). The high bits (H1) pick the first
+// group, and a lookup compares H2 against 16 control bytes at a time, so it
+// touches a slot only on a likely match and stops at the first group with an
+// EMPTY byte. Capacity is a power of two (index = hash & mask), the first 15
+// control bytes are mirrored after the last so a group read never wraps, and
+// groups are probed in triangular steps, which visits every group once.
+// Erase leaves a DELETED tombstone only when a probe may have passed over the
+// slot; tombstones are purged by an in-place rehash when the table runs out of
+// room but is not actually full.
+template<typename K, typename V, typename Hash = std::hash<K>>
+class FlatHashMap {
+public:
+    struct Slot {
+        K key;
+        V value;
+    };
+    
+    FlatHashMap() { allocate(MIN_CAPACITY); }
+    explicit FlatHashMap(size_t expected) { allocate(capacityFor(expected)); }
+    ~FlatHashMap() { destroySlots(); }
+    
+    FlatHashMap(const FlatHashMap&) = delete;
+    FlatHashMap& operator=(const FlatHashMap&) = delete;
+    
+    // Insert or update; true if the key was new
+    bool insert(const K& key, const V& value) {
+        size_t hash = hashOf(key);
+        size_t index = findIndex(key, hash);
+        if (index != NOT_FOUND) {
+            slot(index)->value = value;
+            return false;
+        }
+        index = prepareInsert(hash);
+        new (&slots_[index]) Slot{key, value};
+        ++size_;
+        return true;
+    }
+    
+    // Pointer to the stored value, nullptr if absent; stays valid until the
+    // next insert or remove
+    V* find(const K& key) {
+        size_t index = findIndex(key, hashOf(key));
+        return index == NOT_FOUND ? nullptr : &slot(index)->value;
+    }
+    
+    const V* find(const K& key) const {
+        size_t index = findIndex(key, hashOf(key));
+        return index == NOT_FOUND ? nullptr : &slot(index)->value;
+    }
+    
+    std::optional<V> search(const K& key) const {
+        const V* value = find(key);
+        return value ? std::optional<V>(*value) : std::nullopt;
+    }
+    
+    bool contains(const K& key) const { return find(key) != nullptr; }
+    
+    bool remove(const K& key) {
+        size_t index = findIndex(key, hashOf(key));
+        if (index == NOT_FOUND) return false;
+        slot(index)->~Slot();
+        --size_;
+        
+        // If the EMPTY bytes on either side leave no run of WIDTH non-empty
+        // slots through this one, no probe ever went past it and it can be
+        // EMPTY again; otherwise a later key's probe may depend on it
+        uint32_t emptyAfter = ControlGroup(&control_[index]).matchEmpty();
+        uint32_t emptyBefore = ControlGroup(&control_[(index - WIDTH) & mask_]).matchEmpty();
+        size_t runAfter = emptyAfter ? lowestSetBit(emptyAfter) : WIDTH;
+        size_t runBefore = emptyBefore ? WIDTH - 1 - highestSetBit(emptyBefore) : WIDTH;
+        if (runBefore + runAfter < WIDTH) {
+            setControl(index, ControlGroup::EMPTY);
+            ++growthLeft_;
+        } else {
+            setControl(index, ControlGroup::DELETED);
+            ++tombstones_;
+        }
+        return true;
+    }
+    
+    void clear() {
+        destroySlots();
+        std::fill(control_.get(), control_.get() + capacity_ + WIDTH - 1, ControlGroup::EMPTY);
+        size_ = 0;
+        tombstones_ = 0;
+        growthLeft_ = maxLoad(capacity_);
+    }
+    
+    // Properties
+    size_t size() const { return size_; }
+    size_t capacity() const { return capacity_; }
+    bool empty() const { return size_ == 0; }
+    double loadFactor() const { return static_cast<double>(size_) / capacity_; }
+    size_t tombstones() const { return tombstones_; }
+    
+    // Groups a successful lookup reads, averaged over all stored keys
+    double averageProbeGroups() const {
+        size_t groups = 0;
+        for (size_t i = 0; i < capacity_; ++i) {
+            if (control_[i] < 0) continue;
+            size_t hash = hashOf(slot(i)->key);
+            for (size_t position = hash >> 7 & mask_, step = 0;; position = (position + (step += WIDTH)) & mask_) {
+                ++groups;
+                if (ControlGroup(&control_[position]).match(control_[i]) && inGroup(i, position)) break;
+            }
+        }
+        return size_ ? static_cast<double>(groups) / size_ : 0.0;
     }
+    
+    // Statistics
+    void printStatistics() const {
+        std::cout << "\nHash Table Statistics (Swiss Table):" << std::endl;
+        std::cout << "Size: " << size_ << std::endl;
+        std::cout << "Capacity: " << capacity_ << std::endl;
+        std::cout << "Groups of " << WIDTH << ": " << capacity_ / WIDTH << std::endl;
+        std::cout << "Load Factor: " << std::fixed << std::setprecision(3) << loadFactor() << std::endl;
+        std::cout << "Tombstones: " << tombstones_ << std::endl;
+        std::cout << "Average Groups per Lookup: " << std::setprecision(2) << averageProbeGroups() << std::endl;
+    }
+    
+private:
+    static constexpr size_t WIDTH = ControlGroup::WIDTH;
+    static constexpr size_t MIN_CAPACITY = WIDTH;
+    static constexpr size_t NOT_FOUND = std::numeric_limits<size_t>::max();
+    
+    struct alignas(Slot) SlotStorage {
+        unsigned char bytes[sizeof(Slot)];
+    };
+    
+    // 7/8 maximum load factor
+    static size_t maxLoad(size_t capacity) { return capacity - capacity / 8; }
+    
+    static size_t capacityFor(size_t expected) {
+        size_t capacity = MIN_CAPACITY;
+        while (maxLoad(capacity) < expected) capacity *= 2;
+        return capacity;
+    }
+    
+    static unsigned highestSetBit(uint32_t mask) {
+#if defined(__GNUC__) || defined(__clang__)
+        return 31 - static_cast<unsigned>(__builtin_clz(mask));
+#else
+        unsigned bit = 31;
+        while (!(mask & (1u << bit))) --bit;
+        return bit;
+#endif
+    }
+    
+    // std::hash of an integer is often the identity; mix so both the H1
+    // (high) and H2 (low 7) bits depend on every key bit
+    size_t hashOf(const K& key) const {
+        uint64_t h = static_cast<uint64_t>(hasher_(key));
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ULL;
+        h ^= h >> 33;
+        return static_cast<size_t>(h);
+    }
+    
+    static int8_t h2(size_t hash) { return static_cast<int8_t>(hash & 0x7F); }
+    
+    bool inGroup(size_t index, size_t position) const { return ((index - position) & mask_) < WIDTH; }
+    
+    Slot* slot(size_t index) { return std::launder(reinterpret_cast<Slot*>(&slots_[index])); }
+    const Slot* slot(size_t index) const { return std::launder(reinterpret_cast<const Slot*>(&slots_[index])); }
+    
+    size_t findIndex(const K& key, size_t hash) const {
+        const int8_t tag = h2(hash);
+        for (size_t position = hash >> 7 & mask_, step = 0;; position = (position + (step += WIDTH)) & mask_) {
+            ControlGroup group(&control_[position]);
+            for (uint32_t matches = group.match(tag); matches; matches &= matches - 1) {
+                size_t index = (position + lowestSetBit(matches)) & mask_;
+                if (slot(index)->key == key) return index;
+            }
+            if (group.matchEmpty()) return NOT_FOUND;
+        }
+    }
+    
+    size_t findFirstNonFull(size_t hash) const {
+        for (size_t position = hash >> 7 & mask_, step = 0;; position = (position + (step += WIDTH)) & mask_) {
+            uint32_t free = ControlGroup(&control_[position]).matchEmptyOrDeleted();
+            if (free) return (position + lowestSetBit(free)) & mask_;
+        }
+    }
+    
+    // Claim the slot a new key goes to, growing (or purging tombstones)
+    // first when only EMPTY slots are left to take
+    size_t prepareInsert(size_t hash) {
+        size_t index = findFirstNonFull(hash);
+        if (growthLeft_ == 0 && control_[index] != ControlGroup::DELETED) {
+            // Mostly tombstones: same capacity; really full: double
+            rehash(size_ < maxLoad(capacity_) / 2 ? capacity_ : capacity_ * 2);
+            index = findFirstNonFull(hash);
+        }
+        if (control_[index] == ControlGroup::EMPTY) {
+            --growthLeft_;
+        } else {
+            --tombstones_;
+        }
+        setControl(index, h2(hash));
+        return index;
+    }
+    
+    void setControl(size_t index, int8_t value) {
+        control_[index] = value;
+        if (index < WIDTH - 1) control_[capacity_ + index] = value; // Mirror
+    }
+    
+    void allocate(size_t capacity) {
+        capacity_ = capacity;
+        mask_ = capacity - 1;
+        control_.reset(new int8_t[capacity + WIDTH - 1]);
+        std::fill(control_.get(), control_.get() + capacity + WIDTH - 1, ControlGroup::EMPTY);
+        slots_.reset(new SlotStorage[capacity]);
+        growthLeft_ = maxLoad(capacity) - size_;
+        tombstones_ = 0;
+    }
+    
+    void rehash(size_t newCapacity) {
+        std::unique_ptr<int8_t[]> oldControl = std::move(control_);
+        std::unique_ptr<SlotStorage[]> oldSlots = std::move(slots_);
+        size_t oldCapacity = capacity_;
+        allocate(newCapacity);
+        
+        for (size_t i = 0; i < oldCapacity; ++i) {
+            if (oldControl[i] < 0) continue;
+            Slot* from = std::launder(reinterpret_cast<Slot*>(&oldSlots[i]));
+            size_t hash = hashOf(from->key);
+            size_t index = findFirstNonFull(hash);
+            setControl(index, h2(hash));
+            new (&slots_[index]) Slot(std::move(*from));
+            from->~Slot();
+        }
+    }
+    
+    void destroySlots() {
+        if (!control_) return;
+        for (size_t i = 0; i < capacity_; ++i) {
+            if (control_[i] >= 0) slot(i)->~Slot();
+        }
+    }
+    
+    std::unique_ptr<int8_t[]> control_;   // capacity_ + WIDTH - 1 bytes
+    std::unique_ptr<SlotStorage[]> slots_; // raw storage; constructed where control_ is full
+    size_t capacity_ = 0;
+    size_t mask_ = 0;
+    size_t size_ = 0;
+    size_t growthLeft_ = 0;  // EMPTY slots that may still be filled before a rehash
+    size_t tombstones_ = 0;
+    Hash hasher_;
 };
 
 // Utility functions for demonstration
@@ -762,7 +1364,451 @@ void demonstratePerformanceCharacteristics() {
     }
 }
 
-int main() {
+void demonstrateSwissTable() {
+    printSeparator("SWISS TABLE (FLAT HASH MAP WITH SIMD PROBING)");
+    
+#if defined(__SSE2__)
+    std::cout << "Group probing: SSE2, 16 control bytes per compare" << std::endl;
+#else
+    std::cout << "Group probing: portable byte loop (no SSE2)" << std::endl;
+#endif
+    
+    FlatHashMap<std::string, int> population;
+    std::vector<std::pair<std::string, int>> cities = {
+        {"Tokyo", 37}, {"Delhi", 33}, {"Shanghai", 29}, {"Dhaka", 23},
+        {"Cairo", 22}, {"Mumbai", 21}, {"Beijing", 21}, {"Osaka", 19}
+    };
+    for (const auto& [city, millions] : cities) {
+        population.insert(city, millions);
+    }
+    
+    std::cout << "Delhi: " << *population.search("Delhi") << " million" << std::endl;
+    std::cout << "Lagos: " << (population.contains("Lagos") ? "found" : "not found") << std::endl;
+    
+    // Update in place through the returned pointer
+    if (int* tokyo = population.find("Tokyo")) ++*tokyo;
+    std::cout << "Tokyo after update: " << *population.search("Tokyo") << " million" << std::endl;
+    
+    population.remove("Osaka");
+    population.remove("Cairo");
+    population.printStatistics();
+    
+    std::cout << "\n--- 1000 Inserts, Every Other Key Removed ---" << std::endl;
+    FlatHashMap<int, int> squares;
+    for (int i = 0; i < 1000; ++i) squares.insert(i, i * i);
+    for (int i = 0; i < 1000; i += 2) squares.remove(i);
+    squares.printStatistics();
+}
+
+void demonstrateRobinHood() {
+    printSeparator("ROBIN HOOD HASHING");
+    
+    // Keys 1, 17, 33 and 49 share home slot 1 in a table of 16 and 2 and 3
+    // sit in their way; Robin Hood evens out the distances (+n = slots from home)
+    HashTableOpenAddressing<int, std::string, ProbingPolicy::ROBIN_HOOD> hashTable(16);
+    hashTable.setVerbose(false);
+    for (int key : {2, 3, 1, 17, 33, 49}) {
+        hashTable.insert(key, "v" + std::to_string(key));
+    }
+    hashTable.displayTable();
+    
+    std::cout << "\n--- Backward-Shift Deletion of 17 ---" << std::endl;
+    hashTable.remove(17);
+    hashTable.displayTable();
+    hashTable.printStatistics();
+    
+    auto result = hashTable.search(49);
+    std::cout << "Search for key 49 after deleting 17: " << (result ? *result : "Not found") << std::endl;
+}
+
+// ============================================================================
+// BENCHMARKS
+// ============================================================================
+
+using BenchClock = std::chrono::steady_clock;
+
+double nanosecondsSince(BenchClock::time_point start) {
+    return std::chrono::duration<double, std::nano>(BenchClock::now() - start).count();
+}
+
+// Bytes currently allocated from the heap, including mmap'd blocks
+size_t heapBytesInUse() {
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+#else
+    return 0;
+#endif
+}
+
+// Hand freed memory back before the next measured run. Otherwise the first
+// large allocation of that run pays to consolidate millions of freed nodes
+void releaseFreedHeap() {
+#if defined(__GLIBC__)
+    malloc_trim(0);
+#endif
+}
+
+// Distinct pseudo-random keys: splitmix64 is a bijection on 64-bit words,
+// so key i never repeats, and keys from another base never collide with it
+uint64_t benchKey(uint64_t i) {
+    uint64_t z = i + 0x9e3779b97f4a7c15ULL;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+constexpr uint64_t MISS_BASE = uint64_t(1) << 62;
+
+// Uniform operations over the four tables under test
+template<typename Table>
+void benchInsert(Table& table, uint64_t key, uint64_t value) { table.insert(key, value); }
+template<typename Table>
+bool benchFind(const Table& table, uint64_t key) { return table.contains(key); }
+template<typename Table>
+void benchErase(Table& table, uint64_t key) { table.remove(key); }
+
+void benchInsert(std::unordered_map<uint64_t, uint64_t>& table, uint64_t key, uint64_t value) { table[key] = value; }
+bool benchFind(const std::unordered_map<uint64_t, uint64_t>& table, uint64_t key) { return table.find(key) != table.end(); }
+void benchErase(std::unordered_map<uint64_t, uint64_t>& table, uint64_t key) { table.erase(key); }
+
+template<typename Table>
+void quiet(Table& table) { table.setVerbose(false); }
+template<typename K, typename V, typename H>
+void quiet(FlatHashMap<K, V, H>&) {}
+void quiet(std::unordered_map<uint64_t, uint64_t>&) {}
+
+struct TableTiming {
+    double insertNs = 0, hitNs = 0, missNs = 0, eraseNs = 0;
+    double bytesPerEntry = 0;
+    bool correct = true;
+};
+
+// ns per operation. Small tables repeat the whole build or the lookups until
+// at least minOps operations have run; lookups and erases visit the keys in
+// a scattered order (i * a large prime mod n)
+template<typename Table>
+TableTiming timeTable(size_t n, size_t minOps) {
+    TableTiming timing;
+    const uint64_t stride = 1000000007ULL;
+    size_t rounds = (minOps + n - 1) / n;
+    
+    double insertNs = 0;
+    for (size_t r = 0; r < rounds; ++r) {
+        Table table;
+        quiet(table);
+        auto start = BenchClock::now();
+        for (size_t i = 0; i < n; ++i) benchInsert(table, benchKey(i), i);
+        insertNs += nanosecondsSince(start);
+    }
+    timing.insertNs = insertNs / (rounds * n);
+    
+    {
+        size_t heapBefore = heapBytesInUse();
+        Table table;
+        quiet(table);
+        for (size_t i = 0; i < n; ++i) benchInsert(table, benchKey(i), i);
+        timing.bytesPerEntry = static_cast<double>(heapBytesInUse() - heapBefore) / n;
+        
+        size_t lookups = std::max(n, minOps), found = 0;
+        auto start = BenchClock::now();
+        for (size_t i = 0; i < lookups; ++i) found += benchFind(table, benchKey(i * stride % n));
+        timing.hitNs = nanosecondsSince(start) / lookups;
+        timing.correct = found == lookups;
+        
+        found = 0;
+        start = BenchClock::now();
+        for (size_t i = 0; i < lookups; ++i) found += benchFind(table, benchKey(MISS_BASE + i));
+        timing.missNs = nanosecondsSince(start) / lookups;
+        timing.correct = timing.correct && found == 0;
+    }
+    
+    double eraseNs = 0;
+    for (size_t r = 0; r < rounds; ++r) {
+        Table table;
+        quiet(table);
+        for (size_t i = 0; i < n; ++i) benchInsert(table, benchKey(i), i);
+        auto start = BenchClock::now();
+        for (size_t i = 0; i < n; ++i) benchErase(table, benchKey(i * stride % n));
+        eraseNs += nanosecondsSince(start);
+        timing.correct = timing.correct && table.size() == 0;
+    }
+    timing.eraseNs = eraseNs / (rounds * n);
+    return timing;
+}
+
+// Session-cache churn: liveKeys entries at 40% load, then every step expires
+// the oldest key and inserts a new one, so the size never changes. After
+// each epoch of liveKeys / 2 steps, lookups of live and absent keys are
+// timed and the probe-distance distribution is taken.
+void benchmarkChurn(size_t liveKeys, size_t epochs) {
+    printSeparator("BENCHMARK: INSERT/ERASE CHURN, LINEAR PROBING VS ROBIN HOOD");
+    liveKeys = std::max<size_t>(liveKeys, 1000);
+    const size_t capacity = liveKeys * 5 / 2;
+    const size_t lookups = std::min<size_t>(liveKeys, 200000);
+    std::cout << liveKeys << " live keys, capacity " << capacity << ", " << liveKeys / 2
+              << " churn steps per epoch" << std::endl;
+    
+    struct Row {
+        size_t epoch;
+        const char* table;
+        double churnNs, hitNs, missNs;
+        double meanDistance;
+        size_t p99Distance, maxDistance;
+        double missProbes;
+        size_t tombstones, capacity;
+        bool correct;
+    };
+    std::vector<Row> rows;
+    
+    auto run = [&](const char* name, auto& table) {
+        table.setVerbose(false);
+        for (size_t i = 0; i < liveKeys; ++i) table.insert(benchKey(i), i);
+        
+        size_t oldest = 0;
+        uint64_t state = 88172645463325252ULL;
+        for (size_t epoch = 0; epoch <= epochs; ++epoch) {
+            double churnNs = 0;
+            if (epoch > 0) {
+                auto start = BenchClock::now();
+                for (size_t step = 0; step < liveKeys / 2; ++step, ++oldest) {
+                    table.remove(benchKey(oldest));
+                    table.insert(benchKey(oldest + liveKeys), oldest);
+                }
+                churnNs = nanosecondsSince(start) / (liveKeys / 2);
+            }
+            
+            size_t found = 0;
+            auto start = BenchClock::now();
+            for (size_t i = 0; i < lookups; ++i) {
+                state ^= state << 13;
+                state ^= state >> 7;
+                state ^= state << 17;
+                found += table.contains(benchKey(oldest + state % liveKeys));
+            }
+            double hitNs = nanosecondsSince(start) / lookups;
+            
+            start = BenchClock::now();
+            for (size_t i = 0; i < lookups; ++i) found += table.contains(benchKey(MISS_BASE + epoch * lookups + i));
+            double missNs = nanosecondsSince(start) / lookups;
+            
+            auto distances = table.probeDistances();
+            size_t total = 0, seen = 0, p99 = 0;
+            for (size_t d = 0; d < distances.size(); ++d) total += d * distances[d];
+            for (size_t d = 0; d < distances.size(); ++d) {
+                seen += distances[d];
+                if (seen * 100 >= table.size() * 99) {
+                    p99 = d;
+                    break;
+                }
+            }
+            rows.push_back({epoch, name, churnNs, hitNs, missNs, static_cast<double>(total) / table.size(), p99,
+                            distances.size() - 1, table.averageMissProbes(), table.tombstones(), table.capacity(),
+                            found == lookups && table.size() == liveKeys});
+        }
+    };
+    
+    {
+        HashTableOpenAddressing<uint64_t, uint64_t> linear(capacity);
+        run("linear probing", linear);
+    }
+    {
+        HashTableOpenAddressing<uint64_t, uint64_t, ProbingPolicy::ROBIN_HOOD> robinHood(capacity);
+        run("robin hood", robinHood);
+    }
+    
+    std::cout << "\n" << std::setw(6) << "epoch" << "  " << std::left << std::setw(16) << "table" << std::right
+              << std::setw(10) << "churn ns" << std::setw(9) << "hit ns" << std::setw(9) << "miss ns"
+              << std::setw(11) << "mean dist" << std::setw(10) << "p99 dist" << std::setw(10) << "max dist"
+              << std::setw(13) << "miss probes" << std::setw(12) << "tombstones" << std::setw(10) << "capacity"
+              << std::setw(9) << "correct" << std::endl;
+    for (const auto& row : rows) {
+        std::cout << std::setw(6) << row.epoch << "  " << std::left << std::setw(16) << row.table << std::right
+                  << std::fixed << std::setprecision(1) << std::setw(10) << row.churnNs
+                  << std::setw(9) << row.hitNs << std::setw(9) << row.missNs
+                  << std::setprecision(2) << std::setw(11) << row.meanDistance
+                  << std::setw(10) << row.p99Distance << std::setw(10) << row.maxDistance
+                  << std::setw(13) << row.missProbes << std::setw(12) << row.tombstones
+                  << std::setw(10) << row.capacity << std::setw(9) << (row.correct ? "yes" : "NO") << std::endl;
+    }
+}
+
+// Every insert into a growing chaining table is timed on its own, once with
+// the all-at-once rehash and once with the incremental one. Service time is
+// the insert alone. Response time replays those service times against
+// requests arriving at a fixed rate, served in order: a request that lands
+// during a long rehash waits for it, which per-insert timing never shows.
+void benchmarkIncrementalRehash(size_t entries, double arrivalsPerSecond) {
+    printSeparator("BENCHMARK: INSERT LATENCY DURING GROWTH, CHAINING TABLE");
+    std::cout << entries << " inserts from the default capacity of 16, uint64_t keys and values; response times"
+              << " at " << std::fixed << std::setprecision(0) << arrivalsPerSecond << " inserts/s" << std::endl;
+    
+    struct Row {
+        const char* mode;
+        const char* measure;
+        double totalMs;
+        double p50, p99, p999, p9999, max; // ns
+        bool correct;
+    };
+    std::vector<Row> rows;
+    std::vector<float> service(entries), response(entries);
+    
+    for (bool incremental : {false, true}) {
+        double totalMs = 0;
+        bool correct = true;
+        {
+            HashTableChaining<uint64_t, uint64_t> table;
+            table.setVerbose(false);
+            table.setIncrementalResize(incremental);
+            for (size_t i = 0; i < entries; ++i) {
+                uint64_t key = benchKey(i);
+                auto start = BenchClock::now();
+                table.insert(key, i);
+                service[i] = static_cast<float>(nanosecondsSince(start));
+                totalMs += service[i] / 1e6;
+            }
+            for (size_t i = 0; i < entries && correct; i += 97) correct = table.search(benchKey(i)) == i;
+            correct = correct && table.size() == entries;
+        }
+        releaseFreedHeap();
+        
+        // Single FIFO server: start at arrival or when the previous insert ends
+        const double interval = 1e9 / arrivalsPerSecond;
+        double finished = 0;
+        for (size_t i = 0; i < entries; ++i) {
+            double arrival = i * interval;
+            finished = std::max(finished, arrival) + service[i];
+            response[i] = static_cast<float>(finished - arrival);
+        }
+        
+        for (auto* latencies : {&service, &response}) {
+            auto percentile = [latencies](double fraction) {
+                auto nth = latencies->begin() + static_cast<size_t>(fraction * (latencies->size() - 1));
+                std::nth_element(latencies->begin(), nth, latencies->end());
+                return static_cast<double>(*nth);
+            };
+            double p50 = percentile(0.5), p99 = percentile(0.99), p999 = percentile(0.999), p9999 = percentile(0.9999);
+            double max = *std::max_element(latencies->begin(), latencies->end());
+            rows.push_back({incremental ? "incremental" : "all at once", latencies == &service ? "service" : "response",
+                            totalMs, p50, p99, p999, p9999, max, correct});
+        }
+    }
+    
+    auto format = [](double ns) {
+        std::ostringstream text;
+        text << std::fixed << std::setprecision(ns < 1e6 ? 1 : 0) << (ns < 1e6 ? ns / 1e3 : ns / 1e6) << (ns < 1e6 ? " us" : " ms");
+        return text.str();
+    };
+    std::cout << "\n" << std::left << std::setw(13) << "rehash" << std::setw(10) << "latency" << std::right
+              << std::setw(10) << "total ms" << std::setw(11) << "p50" << std::setw(11) << "p99"
+              << std::setw(11) << "p99.9" << std::setw(11) << "p99.99" << std::setw(11) << "max"
+              << std::setw(9) << "correct" << std::endl;
+    for (const auto& row : rows) {
+        std::cout << std::left << std::setw(13) << row.mode << std::setw(10) << row.measure << std::right
+                  << std::fixed << std::setprecision(0) << std::setw(10) << row.totalMs
+                  << std::setw(11) << format(row.p50) << std::setw(11) << format(row.p99)
+                  << std::setw(11) << format(row.p999) << std::setw(11) << format(row.p9999)
+                  << std::setw(11) << format(row.max) << std::setw(9) << (row.correct ? "yes" : "NO") << std::endl;
+    }
+}
+
+// uint64_t -> uint64_t, 1K up to maxEntries in powers of ten. A table is
+// skipped at sizes where its rough footprint (bytes per entry, including the
+// transient copy while it grows) would exceed memoryMb.
+void benchmarkFlatHashMap(size_t maxEntries, size_t memoryMb) {
+    printSeparator("BENCHMARK: SWISS TABLE VS EXISTING TABLES");
+#if defined(__SSE2__)
+    std::cout << "Group probing: SSE2" << std::endl;
+#else
+    std::cout << "Group probing: portable byte loop" << std::endl;
+#endif
+    
+    using Key = uint64_t;
+    struct Row {
+        size_t entries;
+        const char* table;
+        TableTiming timing;
+        bool skipped;
+    };
+    std::vector<Row> rows;
+    const size_t minOps = 2000000;
+    const double budget = static_cast<double>(memoryMb) * 1024 * 1024;
+    
+    for (size_t n = 1000; n <= maxEntries; n *= 10) {
+        auto run = [&](const char* name, double bytesPerEntry, auto timer) {
+            Row row{n, name, {}, n * bytesPerEntry > budget};
+            if (!row.skipped) row.timing = timer(n, minOps);
+            rows.push_back(row);
+        };
+        run("chaining", 112, timeTable<HashTableChaining<Key, Key>>);
+        run("linear probing", 144, timeTable<HashTableOpenAddressing<Key, Key>>);
+        run("std::unordered_map", 64, timeTable<std::unordered_map<Key, Key>>);
+        run("swiss table", 36, timeTable<FlatHashMap<Key, Key>>);
+    }
+    
+    std::cout << "\n" << std::setw(11) << "entries" << "  " << std::left << std::setw(20) << "table" << std::right
+              << std::setw(11) << "insert" << std::setw(11) << "find-hit" << std::setw(11) << "find-miss"
+              << std::setw(11) << "erase" << std::setw(12) << "bytes/entry" << std::setw(9) << "correct"
+              << "   (ns per operation)" << std::endl;
+    for (const auto& row : rows) {
+        std::cout << std::setw(11) << row.entries << "  " << std::left << std::setw(20) << row.table << std::right;
+        if (row.skipped) {
+            std::cout << "   skipped: over the " << memoryMb << " MB budget" << std::endl;
+            continue;
+        }
+        std::cout << std::fixed << std::setprecision(1) << std::setw(11) << row.timing.insertNs
+                  << std::setw(11) << row.timing.hitNs << std::setw(11) << row.timing.missNs
+                  << std::setw(11) << row.timing.eraseNs << std::setprecision(0) << std::setw(12)
+                  << row.timing.bytesPerEntry << std::setw(9) << (row.timing.correct ? "yes" : "NO")
+                  << std::endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::string bench;
+    size_t benchMaxEntries = 10000000;
+    size_t benchMemoryMb = 3072;
+    size_t benchEntries = 0; // Per-benchmark default
+    size_t benchEpochs = 10;
+    double benchRate = 500000;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--bench-flat") {
+            bench = "flat";
+        } else if (arg == "--bench-rehash") {
+            bench = "rehash";
+        } else if (arg == "--bench-churn") {
+            bench = "churn";
+        } else if (arg == "--entries" && i + 1 < argc) {
+            benchEntries = std::stoull(argv[++i]);
+        } else if (arg == "--rate" && i + 1 < argc) {
+            benchRate = std::max(std::stod(argv[++i]), 1.0);
+        } else if (arg == "--epochs" && i + 1 < argc) {
+            benchEpochs = std::stoull(argv[++i]);
+        } else if (arg == "--max-entries" && i + 1 < argc) {
+            benchMaxEntries = std::stoull(argv[++i]);
+        } else if (arg == "--memory-mb" && i + 1 < argc) {
+            benchMemoryMb = std::stoull(argv[++i]);
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--bench-flat [--max-entries N] [--memory-mb MB]]"
+                      << " [--bench-churn [--entries N] [--epochs E]]"
+                      << " [--bench-rehash [--entries N] [--rate INSERTS_PER_S]]" << std::endl;
+            return 1;
+        }
+    }
+    
+    if (!bench.empty()) {
+        try {
+            if (bench == "flat") benchmarkFlatHashMap(benchMaxEntries, benchMemoryMb);
+            if (bench == "churn") benchmarkChurn(benchEntries ? benchEntries : 1000000, benchEpochs);
+            if (bench == "rehash") benchmarkIncrementalRehash(benchEntries ? benchEntries : 10000000, benchRate);
+        } catch (const std::exception& e) {
+            std::cerr << "An error occurred: " << e.what() << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+    
     std::cout << "===============================================" << std::endl;
     std::cout << "        HASH TABLE DEMONSTRATION              " << std::endl;
     std::cout << "===============================================" << std::endl;
@@ -775,6 +1821,8 @@ int main() {
         demonstratePracticalApplications();
         demonstrateHashFunctionQuality();
         demonstratePerformanceCharacteristics();
+        demonstrateSwissTable();
+        demonstrateRobinHood();
         
         printSeparator("COMPREHENSIVE SUMMARY");
         
@@ -12,6 +12,17 @@
 #include <queue>
 #include <mutex>
 #include <string>
+#include <memory>
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <coroutine>
+#include <functional>
+#include <latch>
+#include <shared_mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <cstdio>
 
 // 1. Basic counting semaphore usage
 void demonstrate_basic_semaphore() {
@@ -70,7 +81,7 @@ class ConnectionPool {
 private:
     std::counting_semaphore<20> available_connections;
     std::queue<int> connection_ids;
-    std::mutex pool_mutex;
+    mutable std::mutex pool_mutex;
     std::atomic<int> next_connection_id{1};
     
 public:
@@ -110,8 +121,9 @@ public:
     }
     
     size_t available_count() const {
-        // Note: This is approximate due to race conditions
-        return available_connections.max() - (available_connections.max() - connection_ids.size());
+        // A snapshot: it may be stale by the time the caller looks at it
+        std::lock_guard lock(pool_mutex);
+        return connection_ids.size();
     }
 };
 
@@ -153,7 +165,7 @@ template<typename T, size_t Capacity>
 class BoundedQueue {
 private:
     std::queue<T> queue_;
-    std::mutex queue_mutex_;
+    mutable std::mutex queue_mutex_;
     std::counting_semaphore<Capacity> empty_slots_;
     std::counting_semaphore<Capacity> filled_slots_;
     
@@ -232,6 +244,9 @@ void demonstrate_producer_consumer() {
         while (!production_done.load() || bounded_queue.size() > 0) {
             try {
                 int item = bounded_queue.pop();
+                if (item < 0) {
+                    break; // sentinel: production is over
+                }
                 items_consumed++;
                 std::cout << "Consumer " << id << " consumed item " << item 
                           << " (total consumed: " << items_consumed.load() << ")" << std::endl;
@@ -268,6 +283,11 @@ void demonstrate_producer_consumer() {
     
     std::cout << "Production phase completed. Items produced: " << items_produced.load() 
               << ", Items consumed: " << items_consumed.load() << std::endl;
+    
+    // Consumers block in pop() once the queue is empty: wake each with a sentinel
+    for (int i = 0; i < NUM_CONSUMERS; ++i) {
+        bounded_queue.push(-1);
+    }
 }
 
 // 4. Binary semaphore (specialized for 0/1 states)
@@ -317,8 +337,347 @@ void demonstrate_binary_semaphore() {
     }
 }
 
-// 5. Semaphore-based rate limiting
-class RateLimiter {
+// 5. Rate limiting with a GCRA token bucket
+//
+// The first version of this section was SemaphoreRateLimiter (below, now only
+// kept as the benchmark baseline): every call took a mutex to "refill", and a
+// refill looped try_acquire()/release() once per permit, with the bucket
+// capped at counting_semaphore<100>.
+//
+// GCRA (generic cell rate algorithm) is a token bucket that needs no refill
+// at all. Instead of counting tokens it remembers one number, the theoretical
+// arrival time (TAT): the moment at which the bucket would be full again.
+// With interval T = 1 / rate and capacity C = burst * T, a request for n
+// permits at time `now` is allowed iff
+//         max(TAT, now) + n*T - now <= C
+// and then sets TAT = max(TAT, now) + n*T. That is one 64-bit word, updated
+// with a single compare-and-swap; a denied request does not write at all.
+//
+// Time is kept in 1/16 ns ticks since the limiter was created, so that
+// intervals of fast fractional rates (e.g. 3e8/s: 3.33 ns) round to within
+// 2% instead of 10%+, while 64 bits still last 36 years.
+class GcraRate {
+public:
+    GcraRate(double permits_per_second, double burst)
+        : epoch_(std::chrono::steady_clock::now()),
+          interval_(static_cast<uint64_t>(TICKS_PER_SECOND / permits_per_second + 0.5)),
+          capacity_(static_cast<uint64_t>(burst * TICKS_PER_SECOND / permits_per_second + 0.5)) {
+        if (!(permits_per_second > 0) || burst < 1 || interval_ == 0) {
+            throw std::invalid_argument("GcraRate: rate must be > 0 (and < 1.6e10/s), burst >= 1");
+        }
+    }
+
+    uint64_t now_ticks() const {
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch_);
+        return static_cast<uint64_t>(elapsed.count()) * 16;
+    }
+
+    // Takes n permits from the bucket whose TAT is `tat`, if it has them
+    bool try_acquire(std::atomic<uint64_t>& tat, uint32_t n, uint64_t now) const {
+        uint64_t cost = n * interval_;
+        uint64_t current = tat.load(std::memory_order_relaxed);
+        while (true) {
+            uint64_t start = std::max(current, now);
+            if (start + cost - now > capacity_) {
+                return false;
+            }
+            if (tat.compare_exchange_weak(current, start + cost, std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+    }
+
+    // Takes n permits unconditionally and returns how long the caller must wait
+    // before using them. Reservations queue up in arrival order, first come first
+    // served, without any waiter list: the TAT itself is the queue.
+    std::chrono::nanoseconds reserve(std::atomic<uint64_t>& tat, uint32_t n, uint64_t now) const {
+        uint64_t cost = n * interval_;
+        if (cost > capacity_) {
+            throw std::invalid_argument("GcraRate: more permits requested than the burst size");
+        }
+        uint64_t current = tat.load(std::memory_order_relaxed);
+        uint64_t start;
+        do {
+            start = std::max(current, now);
+        } while (!tat.compare_exchange_weak(current, start + cost, std::memory_order_relaxed));
+        uint64_t ready = start + cost > capacity_ ? start + cost - capacity_ : 0;
+        return std::chrono::nanoseconds(ready > now ? (ready - now) / 16 : 0);
+    }
+
+    // A bucket whose TAT has passed is full, i.e. no different from a new one
+    bool is_full(const std::atomic<uint64_t>& tat, uint64_t now) const {
+        return tat.load(std::memory_order_relaxed) <= now;
+    }
+
+private:
+    static constexpr double TICKS_PER_SECOND = 16e9;
+    std::chrono::steady_clock::time_point epoch_;
+    uint64_t interval_;   // ticks per permit
+    uint64_t capacity_;   // burst * interval
+};
+
+// Resumes coroutines once their delay has passed (one thread for all of them)
+class ResumeTimer {
+private:
+    struct Entry {
+        std::chrono::steady_clock::time_point when;
+        std::coroutine_handle<> handle;
+        bool operator>(const Entry& other) const { return when > other.when; }
+    };
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue_;
+    bool stopping_ = false;
+    std::thread worker_;
+
+public:
+    ResumeTimer() : worker_([this] { run(); }) {}
+
+    ~ResumeTimer() {
+        {
+            std::lock_guard lock(mutex_);
+            stopping_ = true;
+        }
+        cv_.notify_one();
+        worker_.join();
+    }
+
+    static ResumeTimer& instance() {
+        static ResumeTimer timer;
+        return timer;
+    }
+
+    void resume_at(std::chrono::steady_clock::time_point when, std::coroutine_handle<> handle) {
+        {
+            std::lock_guard lock(mutex_);
+            queue_.push({when, handle});
+        }
+        cv_.notify_one();
+    }
+
+private:
+    void run() {
+        std::unique_lock lock(mutex_);
+        while (!stopping_) {
+            if (queue_.empty()) {
+                cv_.wait(lock);
+                continue;
+            }
+            auto when = queue_.top().when;
+            if (std::chrono::steady_clock::now() < when) {
+                cv_.wait_until(lock, when);   // an earlier entry may arrive meanwhile
+                continue;
+            }
+            Entry next = queue_.top();
+            queue_.pop();
+            lock.unlock();
+            next.handle.resume();
+            lock.lock();
+        }
+    }
+};
+
+class TokenBucket {
+private:
+    GcraRate rate_;
+    alignas(64) std::atomic<uint64_t> tat_{0};   // own cache line: it is the only shared write
+
+public:
+    // permits_per_second may be fractional (0.5 = one permit every 2 s);
+    // burst is how many permits an idle bucket can hand out at once
+    TokenBucket(double permits_per_second, double burst) : rate_(permits_per_second, burst) {}
+
+    bool try_acquire(uint32_t n = 1) {
+        return rate_.try_acquire(tat_, n, rate_.now_ticks());
+    }
+
+    // Blocking callers: std::this_thread::sleep_for(bucket.reserve(n))
+    std::chrono::nanoseconds reserve(uint32_t n = 1) {
+        return rate_.reserve(tat_, n, rate_.now_ticks());
+    }
+
+    // Coroutines: co_await bucket.acquire(n) suspends (no thread blocked)
+    // until the n permits are available
+    struct AcquireAwaiter {
+        TokenBucket& bucket;
+        uint32_t n;
+        std::chrono::nanoseconds delay{0};
+
+        bool await_ready() {
+            delay = bucket.reserve(n);
+            return delay.count() == 0;
+        }
+        void await_suspend(std::coroutine_handle<> handle) {
+            ResumeTimer::instance().resume_at(std::chrono::steady_clock::now() + delay, handle);
+        }
+        void await_resume() const noexcept {}
+    };
+
+    AcquireAwaiter acquire(uint32_t n = 1) {
+        return AcquireAwaiter{*this, n};
+    }
+};
+
+// Per-key limits (one bucket per client id) for millions of keys. Each key
+// costs one map entry holding its TAT. The keys are spread over 64 shards.
+// A known key is decided under the shard's shared lock with the same single
+// CAS as above; only a key's first request takes the exclusive lock to insert
+// it. evict_idle() drops keys whose bucket has filled up again, since a full
+// bucket behaves exactly like a key that was never seen.
+template<typename Key, typename Hash = std::hash<Key>>
+class ShardedRateLimiter {
+private:
+    static constexpr size_t SHARDS = 64;
+    struct alignas(64) Shard {
+        std::shared_mutex mutex;
+        std::unordered_map<Key, std::atomic<uint64_t>, Hash> tats;
+    };
+    GcraRate rate_;
+    std::unique_ptr<Shard[]> shards_;
+
+    Shard& shard_for(const Key& key) {
+        // mix the hash: std::hash of an integer is the integer itself
+        return shards_[(Hash{}(key) * 0x9E3779B97F4A7C15ull) >> 58];
+    }
+
+public:
+    ShardedRateLimiter(double permits_per_second, double burst)
+        : rate_(permits_per_second, burst), shards_(new Shard[SHARDS]) {}
+
+    bool try_acquire(const Key& key, uint32_t n = 1) {
+        Shard& shard = shard_for(key);
+        uint64_t now = rate_.now_ticks();
+        {
+            std::shared_lock lock(shard.mutex);
+            auto it = shard.tats.find(key);
+            if (it != shard.tats.end()) {
+                return rate_.try_acquire(it->second, n, now);
+            }
+        }
+        std::unique_lock lock(shard.mutex);
+        auto it = shard.tats.try_emplace(key, 0).first;
+        return rate_.try_acquire(it->second, n, now);
+    }
+
+    size_t evict_idle() {
+        size_t evicted = 0;
+        for (size_t s = 0; s < SHARDS; ++s) {
+            std::unique_lock lock(shards_[s].mutex);
+            uint64_t now = rate_.now_ticks();
+            evicted += std::erase_if(shards_[s].tats, [&](const auto& entry) {
+                return rate_.is_full(entry.second, now);
+            });
+        }
+        return evicted;
+    }
+
+    size_t size() {
+        size_t total = 0;
+        for (size_t s = 0; s < SHARDS; ++s) {
+            std::shared_lock lock(shards_[s].mutex);
+            total += shards_[s].tats.size();
+        }
+        return total;
+    }
+};
+
+void demonstrate_rate_limiting() {
+    std::cout << "\n=== 5. Rate Limiting with a GCRA Token Bucket ===" << std::endl;
+    
+    // Allow 5 permits per second, bursts of up to 10
+    TokenBucket rate_limiter(5, 10);
+    
+    auto api_client = [&](int id) {
+        for (int request = 0; request < 8; ++request) {
+            if (rate_limiter.try_acquire()) {
+                std::cout << "Client " << id << " request " << request << " approved immediately" << std::endl;
+            } else {
+                // Reserve a permit: the bucket says how long until it is ours
+                auto wait_time = rate_limiter.reserve();
+                std::cout << "Client " << id << " request " << request << " rate limited, waiting "
+                          << std::chrono::duration_cast<std::chrono::milliseconds>(wait_time).count()
+                          << "ms..." << std::endl;
+                std::this_thread::sleep_for(wait_time);
+                std::cout << "Client " << id << " request " << request << " approved after waiting" << std::endl;
+            }
+            
+            // Simulate API processing time
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        }
+    };
+    
+    std::vector<std::jthread> clients;
+    for (int i = 0; i < 3; ++i) {
+        clients.emplace_back(api_client, i);
+    }
+}
+
+// 6. Async acquire: co_await instead of blocking a thread
+struct DetachedTask {
+    struct promise_type {
+        DetachedTask get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+DetachedTask rate_limited_job(TokenBucket& bucket, int id, uint32_t permits,
+                              std::chrono::steady_clock::time_point start, std::latch& done) {
+    co_await bucket.acquire(permits);
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    std::cout << "Job " << id << " got " << permits << " permit(s) at " << elapsed.count() << "ms" << std::endl;
+    done.count_down();
+}
+
+void demonstrate_async_acquire() {
+    std::cout << "\n=== 6. Async Acquire with co_await ===" << std::endl;
+    
+    // A fractional rate: 2.5 permits per second, i.e. one every 400 ms, burst of 2
+    TokenBucket bucket(2.5, 2);
+    constexpr int NUM_JOBS = 6;
+    std::latch done(NUM_JOBS);
+    auto start = std::chrono::steady_clock::now();
+    
+    // All jobs start from this thread; the waiting ones are parked in the timer,
+    // not in a blocked thread, and come out in the order they asked
+    for (int i = 0; i < NUM_JOBS; ++i) {
+        rate_limited_job(bucket, i, i == 3 ? 2 : 1, start, done);
+    }
+    std::cout << "Started " << NUM_JOBS << " jobs (job 3 needs 2 permits)" << std::endl;
+    done.wait();
+}
+
+// 7. Per-key limits
+void demonstrate_per_key_limits() {
+    std::cout << "\n=== 7. Per-Key Limits for Many Clients ===" << std::endl;
+    
+    // Every client id may send 2 requests per second, bursts of 3
+    ShardedRateLimiter<uint64_t> limiter(2, 3);
+    
+    int allowed_a = 0, allowed_b = 0;
+    for (int i = 0; i < 10; ++i) {
+        allowed_a += limiter.try_acquire(42);      // a noisy client
+        if (i % 5 == 0) {
+            allowed_b += limiter.try_acquire(7);   // a quiet one is not affected
+        }
+    }
+    std::cout << "Client 42: " << allowed_a << "/10 allowed, client 7: " << allowed_b << "/2 allowed" << std::endl;
+    
+    constexpr uint64_t NUM_CLIENTS = 1000000;
+    for (uint64_t id = 0; id < NUM_CLIENTS; ++id) {
+        limiter.try_acquire(id);
+    }
+    std::cout << "Tracking " << limiter.size() << " client ids" << std::endl;
+    
+    std::this_thread::sleep_for(std::chrono::milliseconds(1600));   // every bucket refills
+    std::cout << "Evicted " << limiter.evict_idle() << " idle ids, " << limiter.size() << " left" << std::endl;
+}
+
+// 8. Benchmark: decisions per second at 64 threads
+// (the original semaphore-based limiter, kept only as the baseline)
+class SemaphoreRateLimiter {
 private:
     std::counting_semaphore<100> permits_;
     std::chrono::steady_clock::time_point last_refill_;
@@ -328,7 +687,7 @@ private:
     const int permits_per_interval_;
     
 public:
-    RateLimiter(int max_permits, std::chrono::milliseconds refill_interval, int permits_per_interval)
+    SemaphoreRateLimiter(int max_permits, std::chrono::milliseconds refill_interval, int permits_per_interval)
         : permits_(max_permits), last_refill_(std::chrono::steady_clock::now()),
           max_permits_(max_permits), refill_interval_(refill_interval),
           permits_per_interval_(permits_per_interval) {}
@@ -366,47 +725,89 @@ private:
     }
 };
 
-void demonstrate_rate_limiting() {
-    std::cout << "\n=== 5. Rate Limiting with Semaphores ===" << std::endl;
-    
-    // Allow 5 permits per second, max 10 permits
-    RateLimiter rate_limiter(10, std::chrono::milliseconds(200), 1);
-    
-    auto api_client = [&](int id) {
-        for (int request = 0; request < 8; ++request) {
-            auto start = std::chrono::steady_clock::now();
-            
-            if (rate_limiter.try_acquire()) {
-                auto end = std::chrono::steady_clock::now();
-                auto wait_time = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
-                
-                std::cout << "Client " << id << " request " << request 
-                          << " approved immediately (waited " << wait_time.count() << "ms)" << std::endl;
-            } else {
-                std::cout << "Client " << id << " request " << request << " rate limited, waiting..." << std::endl;
-                rate_limiter.acquire(); // Block until permit available
-                
-                auto end = std::chrono::steady_clock::now();
-                auto wait_time = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
-                
-                std::cout << "Client " << id << " request " << request 
-                          << " approved after waiting " << wait_time.count() << "ms" << std::endl;
+template<typename Decide>
+std::pair<double, double> measure_decisions(int num_threads, std::chrono::milliseconds duration, Decide decide) {
+    std::atomic<bool> running{true};
+    std::vector<uint64_t> decisions(num_threads), allowed(num_threads);
+    std::latch ready(num_threads + 1);
+    std::vector<std::jthread> threads;
+    for (int t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&, t]() {
+            std::mt19937_64 gen(t);
+            uint64_t local_decisions = 0, local_allowed = 0;
+            ready.arrive_and_wait();
+            while (running.load(std::memory_order_relaxed)) {
+                for (int i = 0; i < 64; ++i) {
+                    local_allowed += decide(gen);
+                }
+                local_decisions += 64;
             }
-            
-            // Simulate API processing time
-            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            decisions[t] = local_decisions;
+            allowed[t] = local_allowed;
+        });
+    }
+    // Workers cannot start before this arrival, so every decision they make is timed
+    auto start = std::chrono::steady_clock::now();
+    ready.arrive_and_wait();
+    std::this_thread::sleep_for(duration);
+    running = false;
+    for (auto& t : threads) {
+        t.join();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    uint64_t total = 0, total_allowed = 0;
+    for (int t = 0; t < num_threads; ++t) {
+        total += decisions[t];
+        total_allowed += allowed[t];
+    }
+    return {total / seconds, 100.0 * total_allowed / std::max<uint64_t>(total, 1)};
+}
+
+void benchmark_rate_limiters() {
+    std::cout << "\n=== 8. Benchmark: Rate Limiter Decisions/sec at 64 Threads ===" << std::endl;
+    
+    constexpr int NUM_THREADS = 64;
+    const auto duration = std::chrono::milliseconds(500);
+    struct Row { const char* name; double per_second; double allowed_percent; };
+    std::vector<Row> rows;
+    
+    {
+        // 100 permits every 1 ms = 100k/s, the most counting_semaphore<100> can hold
+        SemaphoreRateLimiter limiter(100, std::chrono::milliseconds(1), 100);
+        auto [rate, allowed] = measure_decisions(NUM_THREADS, duration, [&](auto&) { return limiter.try_acquire(); });
+        rows.push_back({"semaphore + mutex refill, one limiter", rate, allowed});
+    }
+    {
+        TokenBucket bucket(100000, 100);
+        auto [rate, allowed] = measure_decisions(NUM_THREADS, duration, [&](auto&) { return bucket.try_acquire(); });
+        rows.push_back({"GCRA bucket, one limiter, 100k/s", rate, allowed});
+    }
+    {
+        TokenBucket bucket(1e9, 1000);
+        auto [rate, allowed] = measure_decisions(NUM_THREADS, duration, [&](auto&) { return bucket.try_acquire(); });
+        rows.push_back({"GCRA bucket, one limiter, 1e9/s", rate, allowed});
+    }
+    {
+        ShardedRateLimiter<uint64_t> limiter(10, 5);
+        constexpr uint64_t NUM_CLIENTS = 1000000;
+        for (uint64_t id = 0; id < NUM_CLIENTS; ++id) {
+            limiter.try_acquire(id);
         }
-    };
+        auto [rate, allowed] = measure_decisions(NUM_THREADS, duration, [&](std::mt19937_64& gen) {
+            return limiter.try_acquire(gen() % NUM_CLIENTS);
+        });
+        rows.push_back({"sharded GCRA, 1M client ids", rate, allowed});
+    }
     
-    std::vector<std::jthread> clients;
-    for (int i = 0; i < 3; ++i) {
-        clients.emplace_back(api_client, i);
+    std::cout << "limiter                               | decisions/s | allowed" << std::endl;
+    for (const Row& row : rows) {
+        printf("%-37s | %11.0f | %6.2f%%\n", row.name, row.per_second, row.allowed_percent);
     }
 }
 
-// 6. Performance comparison and best practices
+// 9. Performance comparison and best practices
 void demonstrate_performance_and_practices() {
-    std::cout << "\n=== 6. Performance and Best Practices ===" << std::endl;
+    std::cout << "\n=== 9. Performance and Best Practices ===" << std::endl;
     
     constexpr int NUM_OPERATIONS = 10000;
     constexpr int NUM_THREADS = 4;
@@ -457,6 +858,9 @@ int main() {
         demonstrate_producer_consumer();
         demonstrate_binary_semaphore();
         demonstrate_rate_limiting();
+        demonstrate_async_acquire();
+        demonstrate_per_key_limits();
+        benchmark_rate_limiters();
         demonstrate_performance_and_practices();
         
     } catch (const std::exception& e) {
@@ -525,6 +929,15 @@ Synchronization:
 - Batch processing
 - Phase synchronization
 
+Rate Limiting (sections 5-8):
+- A semaphore counts permits, so refilling means releasing them one by one
+  under a lock, and the bucket size is capped by the template parameter
+- GCRA stores only the time at which the bucket would be full again: one
+  atomic 64-bit word, one CAS per granted request, no write for a denial
+- Fractional rates and any burst size; reserve() turns the same word into a
+  FIFO queue of waiters, which co_await acquire() builds on
+- Per-key limits: sharded maps of TAT words; full buckets can be forgotten
+
 Performance Characteristics:
 - Generally faster than mutex + condition_variable
 - Optimized for counting operations
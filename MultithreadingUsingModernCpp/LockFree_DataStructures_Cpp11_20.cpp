@@ -13,9 +13,426 @@
 #include <cassert>
 #include <functional>
 #include <type_traits>
+#include <bit>
+#include <shared_mutex>
+#include <unordered_map>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <utility>
+#include <unistd.h>
+#include <algorithm>
+#include <iomanip>
+#include <mutex>
+#include <new>
+#include <queue>
+#include <semaphore>
+#include <string>
 
-// 1. Lock-free stack using atomic pointers
+// 0. Safe memory reclamation policies
+//
+// A lock-free container cannot delete a node right after unlinking it:
+// another thread may still be reading it, and a recycled address can fool
+// a later CAS (ABA). Containers take a Reclaimer policy and instead:
+//   typename Reclaimer::Guard guard;          // pin for the operation
+//   Node* n = guard.protect(0, atomic_ptr);   // safe to dereference
+//   Reclaimer::retire(n);                     // deleted once unreachable
+//
+// HazardPointerReclaimer: bounded garbage, per-pointer publication cost.
+// EpochReclaimer:         nearly free reads, but a stalled reader delays
+//                         all reclamation.
+
+namespace smr {
+
+struct Retired {
+    void* ptr;
+    void (*deleter)(void*);
+    
+    void reclaim() const { deleter(ptr); }
+};
+
+template<typename T>
+Retired make_retired(T* p) {
+    return {p, [](void* q) { delete static_cast<T*>(q); }};
+}
+
+// Low bit of a node pointer is used as a "logically deleted" mark
 template<typename T>
+T* strip_mark(T* p) {
+    return reinterpret_cast<T*>(reinterpret_cast<uintptr_t>(p) & ~uintptr_t{1});
+}
+
+// Per-thread records are kept on an append-only list and reused by later
+// threads, so scanners can walk them without locks.
+template<typename Record>
+class RecordRegistry {
+private:
+    std::atomic<Record*> head_{nullptr};
+    std::atomic<size_t> count_{0};
+    
+public:
+    ~RecordRegistry() {
+        Record* r = head_.load();
+        while (r) {
+            Record* next = r->next;
+            delete r;
+            r = next;
+        }
+    }
+    
+    Record* acquire() {
+        for (Record* r = head_.load(std::memory_order_acquire); r; r = r->next) {
+            bool expected = false;
+            if (!r->in_use.load(std::memory_order_relaxed) &&
+                r->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                return r;
+            }
+        }
+        
+        Record* r = new Record;
+        r->in_use.store(true, std::memory_order_relaxed);
+        Record* old_head = head_.load(std::memory_order_relaxed);
+        do {
+            r->next = old_head;
+        } while (!head_.compare_exchange_weak(old_head, r, std::memory_order_release));
+        count_.fetch_add(1, std::memory_order_relaxed);
+        return r;
+    }
+    
+    void release(Record* r) {
+        r->in_use.store(false, std::memory_order_release);
+    }
+    
+    template<typename F>
+    void for_each(F&& f) const {
+        for (Record* r = head_.load(std::memory_order_acquire); r; r = r->next) {
+            f(*r);
+        }
+    }
+    
+    size_t size() const {
+        return count_.load(std::memory_order_relaxed);
+    }
+};
+
+// Garbage left behind by exiting threads, adopted by the next reclaim pass
+class OrphanList {
+private:
+    std::mutex mutex_;
+    std::vector<std::pair<Retired, uint64_t>> items_;   // (node, retire epoch)
+    
+public:
+    ~OrphanList() {
+        for (const auto& item : items_) item.first.reclaim();
+    }
+    
+    void add(const std::vector<Retired>& retired, uint64_t epoch = 0) {
+        if (retired.empty()) return;
+        std::lock_guard lock(mutex_);
+        for (const auto& r : retired) items_.emplace_back(r, epoch);
+    }
+    
+    // Moves out every orphan whose epoch satisfies pred (non-blocking)
+    template<typename Pred>
+    void adopt(std::vector<Retired>& out, Pred pred) {
+        std::unique_lock lock(mutex_, std::try_to_lock);
+        if (!lock || items_.empty()) return;
+        auto split = std::partition(items_.begin(), items_.end(),
+                                    [&](const auto& item) { return !pred(item.second); });
+        for (auto it = split; it != items_.end(); ++it) out.push_back(it->first);
+        items_.erase(split, items_.end());
+    }
+};
+
+struct ReclaimStats {
+    std::atomic<size_t> retired{0};
+    std::atomic<size_t> reclaimed{0};
+    
+    size_t pending() const { return retired.load() - reclaimed.load(); }
+};
+
+} // namespace smr
+
+// Hazard pointers (Michael, 2004). Each thread publishes up to SLOTS
+// pointers it is about to dereference; a retired node is only deleted by
+// a scan that finds it in nobody's hazard slots.
+class HazardPointerReclaimer {
+public:
+    static constexpr size_t SLOTS = 3;
+    
+private:
+    struct Record {
+        std::atomic<void*> hazards[SLOTS] = {};
+        std::atomic<bool> in_use{false};
+        Record* next = nullptr;
+        std::vector<smr::Retired> retired;   // Owned by the thread holding the record
+    };
+    
+    struct ThreadHandle {
+        Record* record = registry().acquire();
+        
+        ~ThreadHandle() {
+            for (auto& h : record->hazards) h.store(nullptr, std::memory_order_release);
+            scan(*record);
+            orphans().add(record->retired);
+            record->retired.clear();
+            registry().release(record);
+        }
+    };
+    
+    static smr::RecordRegistry<Record>& registry() {
+        static smr::RecordRegistry<Record> instance;
+        return instance;
+    }
+    
+    static smr::OrphanList& orphans() {
+        static smr::OrphanList instance;
+        return instance;
+    }
+    
+    static Record& local() {
+        thread_local ThreadHandle handle;
+        return *handle.record;
+    }
+    
+    static size_t scan_threshold() {
+        return std::max<size_t>(64, 2 * SLOTS * registry().size());
+    }
+    
+    static void scan(Record& self) {
+        orphans().adopt(self.retired, [](uint64_t) { return true; });
+        
+        std::vector<void*> protected_ptrs;
+        protected_ptrs.reserve(SLOTS * registry().size());
+        registry().for_each([&](Record& r) {
+            for (auto& h : r.hazards) {
+                if (void* p = h.load(std::memory_order_seq_cst)) protected_ptrs.push_back(p);
+            }
+        });
+        std::sort(protected_ptrs.begin(), protected_ptrs.end());
+        
+        size_t kept = 0;
+        for (const auto& r : self.retired) {
+            if (std::binary_search(protected_ptrs.begin(), protected_ptrs.end(), r.ptr)) {
+                self.retired[kept++] = r;
+            } else {
+                r.reclaim();
+                stats().reclaimed.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        self.retired.resize(kept);
+    }
+    
+public:
+    static constexpr const char* name() { return "hazard pointers"; }
+    
+    static smr::ReclaimStats& stats() {
+        static smr::ReclaimStats instance;
+        return instance;
+    }
+    
+    class Guard {
+    private:
+        Record& record_;
+        
+    public:
+        Guard() : record_(local()) {}
+        ~Guard() { reset(); }
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+        
+        // Load src and publish it in slot i until the publication is
+        // confirmed by a re-read; the result may then be dereferenced.
+        // A mark bit in the pointer is preserved but not published.
+        template<typename T>
+        T* protect(size_t i, const std::atomic<T*>& src) {
+            T* p = src.load(std::memory_order_relaxed);
+            while (true) {
+                record_.hazards[i].store(smr::strip_mark(p), std::memory_order_seq_cst);
+                T* again = src.load(std::memory_order_seq_cst);
+                if (again == p) return p;
+                p = again;
+            }
+        }
+        
+        // Hand an already-protected pointer to another slot
+        template<typename T>
+        void set(size_t i, T* p) {
+            record_.hazards[i].store(smr::strip_mark(p), std::memory_order_seq_cst);
+        }
+        
+        void reset() {
+            for (auto& h : record_.hazards) h.store(nullptr, std::memory_order_release);
+        }
+    };
+    
+    template<typename T>
+    static void retire(T* p) {
+        Record& self = local();
+        self.retired.push_back(smr::make_retired(p));
+        stats().retired.fetch_add(1, std::memory_order_relaxed);
+        if (self.retired.size() >= scan_threshold()) {
+            scan(self);
+        }
+    }
+    
+    // Reclaim everything this thread can reclaim right now
+    static void flush() {
+        scan(local());
+    }
+};
+
+// Epoch-based reclamation (Fraser, 2004). Threads announce the global
+// epoch while inside an operation; the epoch only advances once every
+// active thread has caught up, so garbage from epoch e is unreachable by
+// the time the global epoch reaches e + 2.
+class EpochReclaimer {
+private:
+    static constexpr uint64_t ACTIVE = 1;
+    static constexpr size_t ADVANCE_EVERY = 64;
+    
+    struct Record {
+        std::atomic<uint64_t> state{0};      // (epoch << 1) | ACTIVE
+        std::atomic<bool> in_use{false};
+        Record* next = nullptr;
+        unsigned nesting = 0;
+        uint64_t seen_epoch = 0;
+        size_t retires_since_advance = 0;
+        std::vector<smr::Retired> bags[3];    // Indexed by retire epoch % 3
+    };
+    
+    struct ThreadHandle {
+        Record* record = registry().acquire();
+        
+        ~ThreadHandle() {
+            uint64_t epoch = global_epoch().load();
+            for (auto& bag : record->bags) {
+                orphans().add(bag, epoch);
+                bag.clear();
+            }
+            registry().release(record);
+        }
+    };
+    
+    static smr::RecordRegistry<Record>& registry() {
+        static smr::RecordRegistry<Record> instance;
+        return instance;
+    }
+    
+    static smr::OrphanList& orphans() {
+        static smr::OrphanList instance;
+        return instance;
+    }
+    
+    static std::atomic<uint64_t>& global_epoch() {
+        static std::atomic<uint64_t> epoch{2};
+        return epoch;
+    }
+    
+    static Record& local() {
+        thread_local ThreadHandle handle;
+        return *handle.record;
+    }
+    
+    static void reclaim_bag(std::vector<smr::Retired>& bag) {
+        for (const auto& r : bag) r.reclaim();
+        stats().reclaimed.fetch_add(bag.size(), std::memory_order_relaxed);
+        bag.clear();
+    }
+    
+    // Free whatever became safe since this thread last looked at the epoch
+    static void collect(Record& self, uint64_t epoch) {
+        if (self.seen_epoch == epoch) return;
+        if (epoch - self.seen_epoch >= 2) {
+            for (auto& bag : self.bags) reclaim_bag(bag);
+        } else {
+            reclaim_bag(self.bags[(epoch + 1) % 3]);   // Retired in epoch - 2
+        }
+        self.seen_epoch = epoch;
+    }
+    
+    static void try_advance() {
+        uint64_t epoch = global_epoch().load(std::memory_order_seq_cst);
+        bool all_caught_up = true;
+        registry().for_each([&](Record& r) {
+            uint64_t state = r.state.load(std::memory_order_seq_cst);
+            if ((state & ACTIVE) && (state >> 1) != epoch) all_caught_up = false;
+        });
+        if (all_caught_up) {
+            global_epoch().compare_exchange_strong(epoch, epoch + 1, std::memory_order_seq_cst);
+        }
+        
+        std::vector<smr::Retired> safe;
+        uint64_t now = global_epoch().load(std::memory_order_acquire);
+        orphans().adopt(safe, [now](uint64_t retired_at) { return retired_at + 2 <= now; });
+        reclaim_bag(safe);
+    }
+    
+public:
+    static constexpr const char* name() { return "epoch-based"; }
+    
+    static smr::ReclaimStats& stats() {
+        static smr::ReclaimStats instance;
+        return instance;
+    }
+    
+    class Guard {
+    private:
+        Record& record_;
+        
+    public:
+        Guard() : record_(local()) {
+            if (record_.nesting++ == 0) {
+                uint64_t epoch = global_epoch().load(std::memory_order_seq_cst);
+                record_.state.store((epoch << 1) | ACTIVE, std::memory_order_seq_cst);
+            }
+        }
+        
+        ~Guard() {
+            if (--record_.nesting == 0) {
+                record_.state.store(0, std::memory_order_release);
+            }
+        }
+        
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+        
+        // Being inside the epoch is the protection; slots are not needed
+        template<typename T>
+        T* protect(size_t, const std::atomic<T*>& src) {
+            return src.load(std::memory_order_acquire);
+        }
+        
+        template<typename T>
+        void set(size_t, T*) {}
+        
+        void reset() {}
+    };
+    
+    template<typename T>
+    static void retire(T* p) {
+        Record& self = local();
+        uint64_t epoch = global_epoch().load(std::memory_order_seq_cst);
+        collect(self, epoch);
+        self.bags[epoch % 3].push_back(smr::make_retired(p));
+        stats().retired.fetch_add(1, std::memory_order_relaxed);
+        
+        if (++self.retires_since_advance >= ADVANCE_EVERY) {
+            self.retires_since_advance = 0;
+            try_advance();
+        }
+    }
+    
+    static void flush() {
+        for (int i = 0; i < 3; ++i) {
+            try_advance();
+            collect(local(), global_epoch().load());
+        }
+    }
+};
+
+// 1. Lock-free stack using atomic pointers (Treiber stack)
+template<typename T, typename Reclaimer = HazardPointerReclaimer>
 class LockFreeStack {
 private:
     struct Node {
@@ -54,16 +471,25 @@ public:
     }
     
     bool pop(T& result) {
-        Node* current_head = head_.load();
+        typename Reclaimer::Guard guard;
+        Node* current_head;
         
-        do {
+        while (true) {
+            // Protected: cannot be freed (or recycled, so no ABA) while we look at it
+            current_head = guard.protect(0, head_);
             if (current_head == nullptr) {
                 return false; // Stack is empty
             }
-        } while (!head_.compare_exchange_weak(current_head, current_head->next.load()));
+            
+            Node* next = current_head->next.load();
+            if (head_.compare_exchange_weak(current_head, next)) {
+                break;
+            }
+        }
         
-        result = current_head->data;
-        delete current_head;
+        result = std::move(current_head->data);
+        guard.reset();
+        Reclaimer::retire(current_head);
         size_.fetch_sub(1, std::memory_order_relaxed);
         return true;
     }
@@ -78,7 +504,7 @@ public:
 };
 
 // 2. Lock-free queue using atomic pointers (Michael & Scott algorithm)
-template<typename T>
+template<typename T, typename Reclaimer = HazardPointerReclaimer>
 class LockFreeQueue {
 private:
     struct Node {
@@ -113,43 +539,71 @@ public:
     
     void enqueue(const T& value) {
         Node* new_node = new Node;
-        T* data = new T(value);
-        new_node->data.store(data);
+        new_node->data.store(new T(value));
         
-        Node* prev_tail = tail_.exchange(new_node);
-        prev_tail->next.store(new_node);
+        typename Reclaimer::Guard guard;
+        while (true) {
+            Node* tail = guard.protect(0, tail_);
+            Node* next = tail->next.load();
+            
+            if (tail != tail_.load()) {
+                continue;
+            }
+            
+            if (next == nullptr) {
+                // Link after the last node, then try to swing tail
+                if (tail->next.compare_exchange_weak(next, new_node)) {
+                    tail_.compare_exchange_strong(tail, new_node);
+                    break;
+                }
+            } else {
+                // Tail is lagging: help the other enqueuer first
+                tail_.compare_exchange_strong(tail, next);
+            }
+        }
         
         size_.fetch_add(1, std::memory_order_relaxed);
     }
     
     bool dequeue(T& result) {
-        Node* head = head_.load();
-        Node* next = head->next.load();
-        
-        if (next == nullptr) {
-            return false; // Queue is empty
-        }
+        typename Reclaimer::Guard guard;
         
-        T* data = next->data.load();
-        if (data == nullptr) {
-            return false; // Another thread got this item
-        }
-        
-        if (!head_.compare_exchange_weak(head, next)) {
-            return false; // Another thread changed head
+        while (true) {
+            Node* head = guard.protect(0, head_);
+            Node* tail = tail_.load();
+            Node* next = guard.protect(1, head->next);
+            
+            if (head != head_.load()) {
+                continue;
+            }
+            
+            if (next == nullptr) {
+                return false; // Queue is empty
+            }
+            
+            if (head == tail) {
+                tail_.compare_exchange_strong(tail, next);
+                continue;
+            }
+            
+            T* data = next->data.load();
+            if (head_.compare_exchange_weak(head, next)) {
+                // We own data now; next becomes the new dummy node
+                next->data.store(nullptr);
+                result = std::move(*data);
+                delete data;
+                guard.reset();
+                Reclaimer::retire(head);
+                size_.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
         }
-        
-        result = *data;
-        delete data;
-        delete head;
-        size_.fetch_sub(1, std::memory_order_relaxed);
-        return true;
     }
     
     bool empty() const {
-        Node* head = head_.load();
-        Node* next = head->next.load();
-        return next == nullptr;
+        typename Reclaimer::Guard guard;
+        Node* head = guard.protect(0, head_);
+        return head->next.load() == nullptr;
     }
     
     size_t size() const {
@@ -158,109 +612,324 @@ public:
 };
 
 // 3. Lock-free hash map using atomic operations
-template<typename Key, typename Value, size_t TableSize = 1024>
+//
+// Split-ordered list (Shalev & Shavit, 2006). All entries live in ONE
+// Harris-Michael lock-free list sorted by bit-reversed hash. A bucket is
+// just a shortcut into that list (a sentinel "dummy" node), so doubling
+// the bucket count never moves an entry: new buckets are initialized
+// lazily by splicing a dummy in after their parent bucket's dummy.
+//
+// - Grows online, no stop-the-world rehash
+// - Arbitrary Key/Value types: keys are immutable in their node, values
+//   are held by pointer and swapped atomically by insert_or_assign
+//   (small trivially copyable values are stored inline in a std::atomic)
+// - Unlinked nodes and replaced values go through the Reclaimer
+template<typename Key, typename Value, typename Reclaimer = HazardPointerReclaimer>
 class LockFreeHashMap {
 private:
     struct Node {
-        std::atomic<Key> key;
-        std::atomic<Value> value;
-        std::atomic<Node*> next{nullptr};
-        std::atomic<bool> deleted{false};
+        const uint64_t so_key;                // Split-order key: LSB 1 = data, 0 = dummy
+        std::atomic<Node*> next{nullptr};     // Low bit set = this node is deleted
         
-        Node(const Key& k, const Value& v) : key(k), value(v) {}
+        explicit Node(uint64_t k) : so_key(k) {}
+        bool is_dummy() const { return (so_key & 1) == 0; }
     };
     
-    std::array<std::atomic<Node*>, TableSize> buckets_;
+    // Saves a pointer chase (and a cache miss) per lookup for int-like values
+    static constexpr bool inline_value() {
+        if constexpr (std::is_trivially_copyable_v<Value> && sizeof(Value) <= sizeof(void*)) {
+            return std::atomic<Value>::is_always_lock_free;
+        }
+        return false;
+    }
+    static constexpr bool INLINE_VALUE = inline_value();
+    using ValueSlot = std::conditional_t<INLINE_VALUE, std::atomic<Value>, std::atomic<Value*>>;
+    
+    struct DataNode : Node {
+        const Key key;
+        ValueSlot value;
+        
+        DataNode(uint64_t so_key, const Key& k, const Value& v) : Node(so_key), key(k) {
+            if constexpr (INLINE_VALUE) {
+                value.store(v, std::memory_order_relaxed);
+            } else {
+                value.store(new Value(v), std::memory_order_relaxed);
+            }
+        }
+        
+        ~DataNode() {
+            if constexpr (!INLINE_VALUE) {
+                delete value.load(std::memory_order_relaxed);
+            }
+        }
+    };
+    
+    static constexpr double MAX_LOAD_FACTOR = 2.0;
+    static constexpr size_t MAX_SEGMENTS = 48;    // Up to 2^47 buckets
+    
+    // Bucket b lives in segment bit_width(b); segment s > 0 holds 2^(s-1)
+    // buckets, so the table grows without ever copying existing buckets
+    std::array<std::atomic<std::atomic<Node*>*>, MAX_SEGMENTS> segments_{};
+    std::atomic<size_t> bucket_count_{2};
     std::atomic<size_t> size_{0};
+    Node* head_;                                  // Dummy for bucket 0
+    
+    static bool is_marked(Node* p) { return reinterpret_cast<uintptr_t>(p) & 1; }
+    static Node* marked(Node* p) { return reinterpret_cast<Node*>(reinterpret_cast<uintptr_t>(p) | 1); }
+    static Node* unmarked(Node* p) { return smr::strip_mark(p); }
     
-    size_t hash(const Key& key) const {
-        return std::hash<Key>{}(key) % TableSize;
+    static uint64_t reverse_bits(uint64_t x) {
+        x = ((x >> 1) & 0x5555555555555555ULL) | ((x & 0x5555555555555555ULL) << 1);
+        x = ((x >> 2) & 0x3333333333333333ULL) | ((x & 0x3333333333333333ULL) << 2);
+        x = ((x >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((x & 0x0F0F0F0F0F0F0F0FULL) << 4);
+        x = ((x >> 8) & 0x00FF00FF00FF00FFULL) | ((x & 0x00FF00FF00FF00FFULL) << 8);
+        x = ((x >> 16) & 0x0000FFFF0000FFFFULL) | ((x & 0x0000FFFF0000FFFFULL) << 16);
+        return (x >> 32) | (x << 32);
     }
     
-public:
-    LockFreeHashMap() {
-        for (auto& bucket : buckets_) {
-            bucket.store(nullptr);
-        }
+    static uint64_t hash_of(const Key& key) {
+        // Finalizer from MurmurHash3: std::hash is often the identity
+        uint64_t h = std::hash<Key>{}(key);
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ULL;
+        h ^= h >> 33;
+        return h & ~(uint64_t{1} << 63);
     }
     
-    ~LockFreeHashMap() {
-        for (auto& bucket : buckets_) {
-            Node* node = bucket.load();
-            while (node) {
-                Node* next = node->next.load();
-                delete node;
-                node = next;
+    static uint64_t data_key(uint64_t hash) { return reverse_bits(hash | (uint64_t{1} << 63)); }
+    static uint64_t dummy_key(size_t bucket) { return reverse_bits(bucket); }
+    
+    std::atomic<Node*>& bucket_slot(size_t bucket) {
+        size_t segment = std::bit_width(bucket);
+        size_t offset = segment == 0 ? 0 : bucket - (size_t{1} << (segment - 1));
+        
+        std::atomic<Node*>* seg = segments_[segment].load(std::memory_order_acquire);
+        if (!seg) {
+            size_t length = segment == 0 ? 1 : size_t{1} << (segment - 1);
+            auto* fresh = new std::atomic<Node*>[length]();
+            if (segments_[segment].compare_exchange_strong(seg, fresh, std::memory_order_acq_rel)) {
+                seg = fresh;
+            } else {
+                delete[] fresh;
             }
         }
+        return seg[offset];
     }
     
-    bool insert(const Key& key, const Value& value) {
-        size_t bucket_index = hash(key);
-        Node* new_node = new Node(key, value);
-        
-        Node* expected = nullptr;
-        if (buckets_[bucket_index].compare_exchange_strong(expected, new_node)) {
-            size_.fetch_add(1, std::memory_order_relaxed);
-            return true;
-        }
-        
-        // Collision - add to chain
-        Node* current = buckets_[bucket_index].load();
-        while (current) {
-            if (current->key.load() == key && !current->deleted.load()) {
-                delete new_node;
-                return false; // Key already exists
+    // Hazard slots: 0 = next, 1 = curr, 2 = node owning *prev (and later the value)
+    struct Position {
+        std::atomic<Node*>* prev;
+        Node* curr;
+        Node* next;
+    };
+    
+    // Harris-Michael search from a dummy node. Returns true with pos.curr ==
+    // the live node matching (so_key, key); otherwise pos.prev/pos.curr is
+    // the insertion point (pos.curr is the first node ordered after it).
+    bool search(Node* start, uint64_t so_key, const Key* key, Position& pos,
+                typename Reclaimer::Guard& guard) {
+    retry:
+        pos.prev = &start->next;
+        pos.curr = guard.protect(1, *pos.prev);
+        
+        while (pos.curr) {
+            pos.next = guard.protect(0, pos.curr->next);
+            if (pos.prev->load() != pos.curr) {
+                goto retry;
             }
             
-            Node* next = current->next.load();
-            if (next == nullptr) {
-                if (current->next.compare_exchange_weak(next, new_node)) {
-                    size_.fetch_add(1, std::memory_order_relaxed);
+            if (is_marked(pos.next)) {
+                Node* expected = pos.curr;
+                if (!pos.prev->compare_exchange_strong(expected, unmarked(pos.next))) {
+                    goto retry;
+                }
+                Reclaimer::retire(static_cast<DataNode*>(pos.curr)); // Dummies are never deleted
+                pos.curr = unmarked(pos.next);
+                guard.set(1, pos.curr);
+                continue;
+            }
+            
+            if (pos.curr->so_key > so_key) {
+                return false;
+            }
+            if (pos.curr->so_key == so_key) {
+                if (!key) return true; // Looking for a dummy
+                if (!pos.curr->is_dummy() && static_cast<DataNode*>(pos.curr)->key == *key) {
                     return true;
                 }
             }
-            current = next;
+            
+            pos.prev = &pos.curr->next;
+            guard.set(2, pos.curr);
+            pos.curr = pos.next;
+            guard.set(1, pos.curr);
         }
         
-        delete new_node;
         return false;
     }
     
-    bool find(const Key& key, Value& result) const {
-        size_t bucket_index = hash(key);
-        Node* current = buckets_[bucket_index].load();
+    // Parent of bucket b is b with its highest set bit cleared
+    Node* get_bucket(size_t bucket) {
+        std::atomic<Node*>& slot = bucket_slot(bucket);
+        Node* dummy = slot.load(std::memory_order_acquire);
+        if (dummy) return dummy;
+        
+        size_t parent = bucket & ~(size_t{1} << (std::bit_width(bucket) - 1));
+        Node* parent_dummy = get_bucket(parent);
+        
+        Node* fresh = new Node(dummy_key(bucket));
+        typename Reclaimer::Guard guard;
+        Position pos;
+        while (true) {
+            if (search(parent_dummy, fresh->so_key, nullptr, pos, guard)) {
+                delete fresh; // Another thread initialized it first
+                dummy = pos.curr;
+                break;
+            }
+            fresh->next.store(pos.curr, std::memory_order_relaxed);
+            Node* expected = pos.curr;
+            if (pos.prev->compare_exchange_strong(expected, fresh)) {
+                dummy = fresh;
+                break;
+            }
+        }
         
-        while (current) {
-            if (current->key.load() == key && !current->deleted.load()) {
-                result = current->value.load();
+        slot.store(dummy, std::memory_order_release);
+        return dummy;
+    }
+    
+    void grow_if_needed(size_t new_size) {
+        size_t buckets = bucket_count_.load(std::memory_order_relaxed);
+        if (static_cast<double>(new_size) / buckets > MAX_LOAD_FACTOR &&
+            buckets < (size_t{1} << (MAX_SEGMENTS - 1))) {
+            bucket_count_.compare_exchange_strong(buckets, buckets * 2, std::memory_order_relaxed);
+        }
+    }
+    
+    // Insert a new node or (if assign) replace the value of an existing one.
+    // Returns true if a new key was inserted.
+    bool upsert(const Key& key, const Value& value, bool assign) {
+        const uint64_t h = hash_of(key);
+        const uint64_t so_key = data_key(h);
+        Node* bucket = get_bucket(h & (bucket_count_.load(std::memory_order_acquire) - 1));
+        
+        DataNode* fresh = nullptr;
+        typename Reclaimer::Guard guard;
+        Position pos;
+        
+        while (true) {
+            if (search(bucket, so_key, &key, pos, guard)) {
+                delete fresh;
+                if (assign) {
+                    auto& slot = static_cast<DataNode*>(pos.curr)->value;
+                    if constexpr (INLINE_VALUE) {
+                        slot.store(value, std::memory_order_release);
+                    } else {
+                        Reclaimer::retire(slot.exchange(new Value(value), std::memory_order_acq_rel));
+                    }
+                }
+                return false;
+            }
+            
+            if (!fresh) fresh = new DataNode(so_key, key, value);
+            fresh->next.store(pos.curr, std::memory_order_relaxed);
+            Node* expected = pos.curr;
+            if (pos.prev->compare_exchange_strong(expected, fresh)) {
+                grow_if_needed(size_.fetch_add(1, std::memory_order_relaxed) + 1);
                 return true;
             }
-            current = current->next.load();
         }
-        
+    }
+    
+public:
+    LockFreeHashMap() {
+        head_ = new Node(dummy_key(0));
+        bucket_slot(0).store(head_);
+    }
+    
+    ~LockFreeHashMap() {
+        Node* node = head_;
+        while (node) {
+            Node* next = unmarked(node->next.load());
+            if (node->is_dummy()) delete node; else delete static_cast<DataNode*>(node);
+            node = next;
+        }
+        for (auto& segment : segments_) {
+            delete[] segment.load();
+        }
+    }
+    
+    LockFreeHashMap(const LockFreeHashMap&) = delete;
+    LockFreeHashMap& operator=(const LockFreeHashMap&) = delete;
+    
+    // Inserts only if key is absent
+    bool insert(const Key& key, const Value& value) {
+        return upsert(key, value, false);
+    }
+    
+    // Returns true if inserted, false if an existing value was replaced
+    bool insert_or_assign(const Key& key, const Value& value) {
+        return upsert(key, value, true);
+    }
+    
+    bool find(const Key& key, Value& result) {
+        const uint64_t h = hash_of(key);
+        Node* bucket = get_bucket(h & (bucket_count_.load(std::memory_order_acquire) - 1));
+        typename Reclaimer::Guard guard;
+        Position pos;
+        
+        if (search(bucket, data_key(h), &key, pos, guard)) {
+            auto& slot = static_cast<DataNode*>(pos.curr)->value;
+            if constexpr (INLINE_VALUE) {
+                result = slot.load(std::memory_order_acquire);
+            } else {
+                // curr stays protected in slot 1; slot 2 now guards the value
+                result = *guard.protect(2, slot);
+            }
+            return true;
+        }
         return false;
     }
     
     bool erase(const Key& key) {
-        size_t bucket_index = hash(key);
-        Node* current = buckets_[bucket_index].load();
-        
-        while (current) {
-            if (current->key.load() == key && !current->deleted.load()) {
-                current->deleted.store(true);
-                size_.fetch_sub(1, std::memory_order_relaxed);
-                return true;
+        const uint64_t h = hash_of(key);
+        const uint64_t so_key = data_key(h);
+        Node* bucket = get_bucket(h & (bucket_count_.load(std::memory_order_acquire) - 1));
+        typename Reclaimer::Guard guard;
+        Position pos;
+        
+        while (true) {
+            if (!search(bucket, so_key, &key, pos, guard)) {
+                return false;
+            }
+            
+            // Logical delete: mark curr's next pointer
+            Node* next = pos.next;
+            if (!pos.curr->next.compare_exchange_strong(next, marked(next))) {
+                continue;
+            }
+            size_.fetch_sub(1, std::memory_order_relaxed);
+            
+            // Physical delete; if that races, a search will finish the job
+            Node* expected = pos.curr;
+            if (pos.prev->compare_exchange_strong(expected, next)) {
+                Reclaimer::retire(static_cast<DataNode*>(pos.curr));
+            } else {
+                search(bucket, so_key, &key, pos, guard);
             }
-            current = current->next.load();
+            return true;
         }
-        
-        return false;
     }
     
     size_t size() const {
         return size_.load(std::memory_order_relaxed);
     }
+    
+    size_t bucket_count() const {
+        return bucket_count_.load(std::memory_order_relaxed);
+    }
 };
 
 // 4. Atomic reference counter for lock-free memory management
@@ -352,8 +1021,8 @@ private:
     static constexpr size_t MASK = Size - 1;
     
     std::array<T, Size> buffer_;
-    std::atomic<size_t> write_pos_{0};
-    std::atomic<size_t> read_pos_{0};
+    alignas(64) std::atomic<size_t> write_pos_{0};  // Own cache lines: producer and
+    alignas(64) std::atomic<size_t> read_pos_{0};   // consumer never false-share
     
 public:
     bool push(const T& item) {
@@ -399,7 +1068,234 @@ public:
     }
 };
 
-// 6. Memory ordering demonstration
+// 6. Lock-free bounded MPMC ring buffer (Dmitry Vyukov's algorithm)
+//
+// Every slot carries a sequence number that says whose turn it is:
+//   sequence == pos      -> free, producer holding ticket pos may write
+//   sequence == pos + 1  -> full, consumer holding ticket pos may read
+// Producers and consumers only contend on their own cursor (one CAS each),
+// and the two cursors live on separate cache lines. Sequences are 32-bit
+// (compared with wrap-around arithmetic) so parking waits on a plain futex.
+template<typename T, size_t Size>
+class MPMCRingBuffer {
+private:
+    static_assert(Size >= 2 && (Size & (Size - 1)) == 0, "Size must be power of 2");
+    static constexpr size_t MASK = Size - 1;
+    static constexpr int SPIN_LIMIT = 128;
+    
+    struct Slot {
+        std::atomic<uint32_t> sequence;
+        std::atomic<uint32_t> waiters{0};    // Threads parked on this slot
+        alignas(T) unsigned char storage[sizeof(T)];
+        
+        T* item() { return std::launder(reinterpret_cast<T*>(storage)); }
+    };
+    
+    std::unique_ptr<Slot[]> slots_;
+    alignas(64) std::atomic<size_t> enqueue_pos_{0};
+    alignas(64) std::atomic<size_t> dequeue_pos_{0};
+    
+    // Make a slot transition visible and wake anyone parked on it
+    static int32_t distance(uint32_t seq, size_t pos) {
+        return static_cast<int32_t>(seq - static_cast<uint32_t>(pos));
+    }
+    
+    void publish(Slot& slot, size_t sequence) {
+        slot.sequence.store(static_cast<uint32_t>(sequence), std::memory_order_release);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (slot.waiters.load(std::memory_order_relaxed) != 0) {
+            slot.sequence.notify_all();
+        }
+    }
+    
+    // Spin, then park on the slot's sequence word (futex-backed atomic wait)
+    void await_sequence(Slot& slot, size_t pos) {
+        const uint32_t wanted = static_cast<uint32_t>(pos);
+        for (int spin = 0; spin < SPIN_LIMIT; ++spin) {
+            if (slot.sequence.load(std::memory_order_acquire) == wanted) return;
+        }
+        
+        while (true) {
+            uint32_t current = slot.sequence.load(std::memory_order_acquire);
+            if (current == wanted) return;
+            
+            slot.waiters.fetch_add(1, std::memory_order_seq_cst);
+            if (slot.sequence.load(std::memory_order_seq_cst) == current) {
+                slot.sequence.wait(current, std::memory_order_acquire);
+            }
+            slot.waiters.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+    
+public:
+    MPMCRingBuffer() : slots_(new Slot[Size]) {
+        for (size_t i = 0; i < Size; ++i) {
+            slots_[i].sequence.store(static_cast<uint32_t>(i), std::memory_order_relaxed);
+        }
+    }
+    
+    // No other thread may use the buffer any more: destroy what is still
+    // queued in place, so T need not be default-constructible or assignable
+    ~MPMCRingBuffer() {
+        const size_t end = enqueue_pos_.load(std::memory_order_relaxed);
+        for (size_t pos = dequeue_pos_.load(std::memory_order_relaxed); pos != end; ++pos) {
+            Slot& slot = slots_[pos & MASK];
+            if (distance(slot.sequence.load(std::memory_order_acquire), pos + 1) == 0) {
+                slot.item()->~T();
+            }
+        }
+    }
+    
+    MPMCRingBuffer(const MPMCRingBuffer&) = delete;
+    MPMCRingBuffer& operator=(const MPMCRingBuffer&) = delete;
+    
+    template<typename U>
+    bool try_push(U&& item) {
+        size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        
+        while (true) {
+            Slot& slot = slots_[pos & MASK];
+            int32_t diff = distance(slot.sequence.load(std::memory_order_acquire), pos);
+            
+            if (diff == 0) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    ::new (slot.storage) T(std::forward<U>(item));
+                    publish(slot, pos + 1);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false; // Buffer full
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+    
+    bool try_pop(T& result) {
+        size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        
+        while (true) {
+            Slot& slot = slots_[pos & MASK];
+            int32_t diff = distance(slot.sequence.load(std::memory_order_acquire), pos + 1);
+            
+            if (diff == 0) {
+                if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    result = std::move(*slot.item());
+                    slot.item()->~T();
+                    publish(slot, pos + Size);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false; // Buffer empty
+            } else {
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+    
+    // Claim up to n consecutive free slots with a single CAS.
+    // Returns how many items from [first, first + n) were pushed.
+    template<typename InputIt>
+    size_t try_push_n(InputIt first, size_t n) {
+        size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        
+        while (true) {
+            size_t ready = 0;
+            while (ready < n && ready < Size &&
+                   distance(slots_[(pos + ready) & MASK].sequence.load(std::memory_order_acquire), pos + ready) == 0) {
+                ++ready;
+            }
+            
+            if (ready == 0) {
+                if (distance(slots_[pos & MASK].sequence.load(std::memory_order_acquire), pos) < 0) {
+                    return 0; // Full
+                }
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+                continue;
+            }
+            
+            if (enqueue_pos_.compare_exchange_weak(pos, pos + ready, std::memory_order_relaxed)) {
+                for (size_t i = 0; i < ready; ++i, ++first) {
+                    Slot& slot = slots_[(pos + i) & MASK];
+                    ::new (slot.storage) T(*first);
+                    publish(slot, pos + i + 1);
+                }
+                return ready;
+            }
+        }
+    }
+    
+    // Claim up to n consecutive full slots with a single CAS.
+    // Returns how many items were written to out.
+    template<typename OutputIt>
+    size_t try_pop_n(OutputIt out, size_t n) {
+        size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        
+        while (true) {
+            size_t ready = 0;
+            while (ready < n && ready < Size &&
+                   distance(slots_[(pos + ready) & MASK].sequence.load(std::memory_order_acquire), pos + ready + 1) == 0) {
+                ++ready;
+            }
+            
+            if (ready == 0) {
+                if (distance(slots_[pos & MASK].sequence.load(std::memory_order_acquire), pos + 1) < 0) {
+                    return 0; // Empty
+                }
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+                continue;
+            }
+            
+            if (dequeue_pos_.compare_exchange_weak(pos, pos + ready, std::memory_order_relaxed)) {
+                for (size_t i = 0; i < ready; ++i, ++out) {
+                    Slot& slot = slots_[(pos + i) & MASK];
+                    *out = std::move(*slot.item());
+                    slot.item()->~T();
+                    publish(slot, pos + i + Size);
+                }
+                return ready;
+            }
+        }
+    }
+    
+    // Blocking push: take a ticket, then spin/park until that slot is free
+    template<typename U>
+    void push(U&& item) {
+        size_t pos = enqueue_pos_.fetch_add(1, std::memory_order_relaxed);
+        Slot& slot = slots_[pos & MASK];
+        await_sequence(slot, pos);
+        ::new (slot.storage) T(std::forward<U>(item));
+        publish(slot, pos + 1);
+    }
+    
+    // Blocking pop: take a ticket, then spin/park until that slot is filled
+    T pop() {
+        size_t pos = dequeue_pos_.fetch_add(1, std::memory_order_relaxed);
+        Slot& slot = slots_[pos & MASK];
+        await_sequence(slot, pos + 1);
+        T result = std::move(*slot.item());
+        slot.item()->~T();
+        publish(slot, pos + Size);
+        return result;
+    }
+    
+    // Approximate under concurrency
+    size_t size() const {
+        size_t enq = enqueue_pos_.load(std::memory_order_relaxed);
+        size_t deq = dequeue_pos_.load(std::memory_order_relaxed);
+        return enq > deq ? std::min(enq - deq, Size) : 0;
+    }
+    
+    bool empty() const {
+        return size() == 0;
+    }
+    
+    static constexpr size_t capacity() {
+        return Size;
+    }
+};
+
+// 7. Memory ordering demonstration
 void demonstrate_memory_ordering() {
     std::cout << "\n=== Memory Ordering Examples ===" << std::endl;
     
@@ -541,6 +1437,255 @@ void test_concurrent_operations(Container& container, const std::string& name,
     std::cout << "Operations/second: " << (completed_ops.load() * 1000000.0) / duration.count() << std::endl;
 }
 
+// Semaphore + mutex bounded queue: same design as BoundedQueue in
+// CountingSemaphore_Cpp20.cpp, minus its per-operation logging
+template<typename T, size_t Capacity>
+class SemaphoreBoundedQueue {
+private:
+    std::queue<T> queue_;
+    std::mutex queue_mutex_;
+    std::counting_semaphore<Capacity> empty_slots_{Capacity};
+    std::counting_semaphore<Capacity> filled_slots_{0};
+    
+public:
+    void push(T item) {
+        empty_slots_.acquire();
+        {
+            std::lock_guard lock(queue_mutex_);
+            queue_.push(std::move(item));
+        }
+        filled_slots_.release();
+    }
+    
+    T pop() {
+        filled_slots_.acquire();
+        T item;
+        {
+            std::lock_guard lock(queue_mutex_);
+            item = std::move(queue_.front());
+            queue_.pop();
+        }
+        empty_slots_.release();
+        return item;
+    }
+};
+
+// Producers stamp each item with its send time; consumers record
+// end-to-end latency. Reports throughput and latency percentiles.
+template<typename Queue>
+void benchmark_bounded_queue(const std::string& name, int producers, int consumers, size_t total_items) {
+    using clock = std::chrono::steady_clock;
+    auto now_ns = []() -> uint64_t {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            clock::now().time_since_epoch()).count());
+    };
+    
+    Queue queue;
+    const size_t per_producer = total_items / producers;
+    const size_t per_consumer = per_producer * producers / consumers;
+    std::vector<std::vector<uint64_t>> latencies(consumers);
+    
+    auto start = clock::now();
+    {
+        std::vector<std::jthread> threads;
+        for (int p = 0; p < producers; ++p) {
+            threads.emplace_back([&]() {
+                for (size_t i = 0; i < per_producer; ++i) {
+                    queue.push(now_ns());
+                }
+            });
+        }
+        for (int c = 0; c < consumers; ++c) {
+            threads.emplace_back([&, c]() {
+                auto& samples = latencies[c];
+                samples.reserve(per_consumer / 16 + 1);
+                for (size_t i = 0; i < per_consumer; ++i) {
+                    uint64_t sent = queue.pop();
+                    if ((i & 15) == 0) samples.push_back(now_ns() - sent);
+                }
+            });
+        }
+    }
+    double seconds = std::chrono::duration<double>(clock::now() - start).count();
+    
+    std::vector<uint64_t> all;
+    for (auto& v : latencies) all.insert(all.end(), v.begin(), v.end());
+    std::sort(all.begin(), all.end());
+    auto pct = [&](double p) { return all.empty() ? 0 : all[static_cast<size_t>(p * (all.size() - 1))]; };
+    
+    std::cout << std::left << std::setw(12) << name << std::right
+              << std::setw(4) << producers << "P" << consumers << "C"
+              << std::setw(14) << static_cast<uint64_t>(per_producer * producers / seconds) << " items/s"
+              << "   p50 " << std::setw(9) << pct(0.50) << " ns"
+              << "   p99 " << std::setw(10) << pct(0.99) << " ns" << std::endl;
+}
+
+void benchmark_mpmc_vs_semaphore_queue() {
+    std::cout << "\n=== MPMC Ring Buffer vs Semaphore BoundedQueue ===" << std::endl;
+    constexpr size_t CAPACITY = 1024;
+    constexpr size_t ITEMS = 400000;
+    
+    for (int threads : {1, 4, 16}) {
+        benchmark_bounded_queue<MPMCRingBuffer<uint64_t, CAPACITY>>("MPMC ring", threads, threads, ITEMS);
+        benchmark_bounded_queue<SemaphoreBoundedQueue<uint64_t, CAPACITY>>("Semaphore", threads, threads, ITEMS);
+    }
+}
+
+// Resident set size in KiB, from /proc/self/statm
+size_t current_rss_kib() {
+    std::ifstream statm("/proc/self/statm");
+    size_t total_pages = 0, resident_pages = 0;
+    statm >> total_pages >> resident_pages;
+    return resident_pages * static_cast<size_t>(sysconf(_SC_PAGESIZE)) / 1024;
+}
+
+// Churns all three containers from several threads for a fixed time and
+// samples RSS. With working reclamation RSS plateaus; without it (or with
+// a use-after-free) the sanitizers or the RSS column will show it.
+// Long soak: LOCKFREE_STRESS_SECONDS=3600 ./lockfree_structures
+// Build with -fsanitize=thread or -fsanitize=address for checked runs
+// (ASan's free quarantine inflates RSS; judge the plateau without it).
+template<typename Reclaimer>
+void stress_test_reclamation(double seconds, int num_threads) {
+    std::cout << "\n--- " << Reclaimer::name() << ": " << num_threads << " threads, "
+              << seconds << " s ---" << std::endl;
+    
+    LockFreeStack<int, Reclaimer> stack;
+    LockFreeQueue<int, Reclaimer> queue;
+    LockFreeHashMap<int, int, Reclaimer> map;
+    
+    std::atomic<bool> stop{false};
+    std::atomic<size_t> operations{0};
+    const size_t rss_start = current_rss_kib();
+    size_t rss_peak = rss_start;
+    
+    {
+        std::vector<std::jthread> threads;
+        for (int t = 0; t < num_threads; ++t) {
+            threads.emplace_back([&, t]() {
+                std::mt19937 gen(static_cast<unsigned>(t) * 7919u + 1);
+                std::uniform_int_distribution<int> key_dist(0, 4095);
+                size_t local_ops = 0;
+                int value;
+                
+                while (!stop.load(std::memory_order_relaxed)) {
+                    for (int i = 0; i < 256; ++i) {
+                        int key = key_dist(gen);
+                        switch (key & 7) {
+                            case 0: case 1: stack.push(key); break;
+                            case 2: case 3: stack.pop(value); break;
+                            case 4: queue.enqueue(key); break;
+                            case 5: queue.dequeue(value); break;
+                            case 6: map.insert(key, key); break;
+                            default:
+                                if (!map.find(key, value)) map.erase(key ^ 1);
+                                break;
+                        }
+                    }
+                    local_ops += 256;
+                }
+                operations.fetch_add(local_ops);
+            });
+        }
+        
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::duration<double>(seconds);
+        int sample = 0;
+        while (std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(250));
+            size_t rss = current_rss_kib();
+            rss_peak = std::max(rss_peak, rss);
+            if (++sample % 4 == 0) {
+                std::cout << "  t=" << sample / 4 << "s rss=" << rss << " KiB, unreclaimed="
+                          << Reclaimer::stats().pending() << std::endl;
+            }
+        }
+        stop = true;
+    }
+    
+    Reclaimer::flush();
+    std::cout << "  operations: " << operations.load()
+              << ", retired: " << Reclaimer::stats().retired.load()
+              << ", reclaimed: " << Reclaimer::stats().reclaimed.load() << std::endl;
+    std::cout << "  RSS start " << rss_start << " KiB, peak " << rss_peak << " KiB" << std::endl;
+}
+
+// Baseline for the hash map benchmark: one reader/writer lock around a std::unordered_map
+template<typename Key, typename Value>
+class SharedMutexHashMap {
+private:
+    std::unordered_map<Key, Value> map_;
+    mutable std::shared_mutex mutex_;
+    
+public:
+    bool insert_or_assign(const Key& key, const Value& value) {
+        std::unique_lock lock(mutex_);
+        return map_.insert_or_assign(key, value).second;
+    }
+    
+    bool find(const Key& key, Value& result) const {
+        std::shared_lock lock(mutex_);
+        auto it = map_.find(key);
+        if (it == map_.end()) return false;
+        result = it->second;
+        return true;
+    }
+    
+    bool erase(const Key& key) {
+        std::unique_lock lock(mutex_);
+        return map_.erase(key) > 0;
+    }
+};
+
+// Mixed find / insert_or_assign / erase over a half-full key space
+template<typename Map>
+double run_hash_map_mix(int num_threads, int read_percent, size_t total_ops) {
+    constexpr int KEY_SPACE = 1 << 17;
+    Map map;
+    for (int k = 0; k < KEY_SPACE; k += 2) map.insert_or_assign(k, k);
+    
+    const size_t per_thread = total_ops / num_threads;
+    auto start = std::chrono::steady_clock::now();
+    {
+        std::vector<std::jthread> threads;
+        for (int t = 0; t < num_threads; ++t) {
+            threads.emplace_back([&, t]() {
+                std::mt19937 gen(static_cast<unsigned>(t) + 1);
+                std::uniform_int_distribution<int> key_dist(0, KEY_SPACE - 1);
+                std::uniform_int_distribution<int> op_dist(0, 99);
+                int value;
+                for (size_t i = 0; i < per_thread; ++i) {
+                    int key = key_dist(gen);
+                    int op = op_dist(gen);
+                    if (op < read_percent) {
+                        map.find(key, value);
+                    } else if (op & 1) {
+                        map.insert_or_assign(key, key);
+                    } else {
+                        map.erase(key);
+                    }
+                }
+            });
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return per_thread * num_threads / seconds / 1e6;
+}
+
+void benchmark_hash_maps() {
+    std::cout << "\n--- Split-ordered LockFreeHashMap vs unordered_map + shared_mutex (Mops/s) ---" << std::endl;
+    constexpr size_t OPS = 400000;
+    
+    std::cout << "threads | 90/10 lock-free | 90/10 shared_mutex | 50/50 lock-free | 50/50 shared_mutex" << std::endl;
+    for (int threads : {1, 2, 4, 8, 16, 32, 64}) {
+        std::cout << std::setw(7) << threads << std::fixed << std::setprecision(2);
+        for (int read_percent : {90, 50}) {
+            std::cout << " | " << std::setw(15) << run_hash_map_mix<LockFreeHashMap<int, int>>(threads, read_percent, OPS)
+                      << " | " << std::setw(18) << run_hash_map_mix<SharedMutexHashMap<int, int>>(threads, read_percent, OPS);
+        }
+        std::cout << std::defaultfloat << std::endl;
+    }
+}
+
 int main() {
     std::cout << "=== Lock-Free Data Structures and Atomic Operations ===" << std::endl;
     
@@ -684,6 +1829,20 @@ int main() {
         std::cout << "Successful inserts: " << successful_inserts.load() << std::endl;
         std::cout << "Successful finds: " << successful_finds.load() << std::endl;
         std::cout << "Final hash map size: " << hashmap.size() << std::endl;
+        
+        // Arbitrary key/value types, in-place updates and online growth
+        LockFreeHashMap<std::string, std::vector<int>> growing;
+        std::cout << "Buckets before growth: " << growing.bucket_count() << std::endl;
+        for (int i = 0; i < 100000; ++i) {
+            growing.insert("key_" + std::to_string(i), {i});
+        }
+        growing.insert_or_assign("key_42", {4, 2});
+        std::vector<int> vec;
+        growing.find("key_42", vec);
+        std::cout << "Buckets after 100000 inserts: " << growing.bucket_count()
+                  << ", key_42 -> {" << vec[0] << ", " << vec[1] << "}" << std::endl;
+        
+        benchmark_hash_maps();
     }
     
     // Test atomic shared pointer
@@ -741,6 +1900,60 @@ int main() {
         std::cout << "Final buffer size: " << ring_buffer.size() << std::endl;
     }
     
+    // Test MPMC ring buffer
+    {
+        std::cout << "\n=== 6. Lock-Free MPMC Ring Buffer Test ===" << std::endl;
+        
+        MPMCRingBuffer<int, 64> mpmc;
+        
+        // Batch operations
+        std::vector<int> batch = {1, 2, 3, 4, 5, 6, 7, 8};
+        size_t pushed = mpmc.try_push_n(batch.begin(), batch.size());
+        std::vector<int> drained(batch.size());
+        size_t popped = mpmc.try_pop_n(drained.begin(), drained.size());
+        std::cout << "Batch pushed " << pushed << ", popped " << popped << ": ";
+        for (size_t i = 0; i < popped; ++i) std::cout << drained[i] << " ";
+        std::cout << std::endl;
+        
+        // Blocking push/pop with several producers and consumers
+        constexpr int PRODUCERS = 4, CONSUMERS = 4, PER_PRODUCER = 10000;
+        std::atomic<long long> sum{0};
+        {
+            std::vector<std::jthread> threads;
+            for (int p = 0; p < PRODUCERS; ++p) {
+                threads.emplace_back([&mpmc, p]() {
+                    for (int i = 1; i <= PER_PRODUCER; ++i) mpmc.push(p * PER_PRODUCER + i);
+                });
+            }
+            for (int c = 0; c < CONSUMERS; ++c) {
+                threads.emplace_back([&mpmc, &sum]() {
+                    long long local = 0;
+                    for (int i = 0; i < PRODUCERS * PER_PRODUCER / CONSUMERS; ++i) local += mpmc.pop();
+                    sum.fetch_add(local);
+                });
+            }
+        }
+        long long n = PRODUCERS * PER_PRODUCER;
+        std::cout << "Sum of consumed values: " << sum.load()
+                  << " (expected " << n * (n + 1) / 2 << ")" << std::endl;
+        
+        benchmark_mpmc_vs_semaphore_queue();
+    }
+    
+    // Safe memory reclamation under churn
+    {
+        std::cout << "\n=== 7. Safe Memory Reclamation Stress Test ===" << std::endl;
+        
+        double seconds = 2.0;
+        if (const char* env = std::getenv("LOCKFREE_STRESS_SECONDS")) {
+            seconds = std::atof(env);
+        }
+        int threads = static_cast<int>(std::max(4u, std::thread::hardware_concurrency()));
+        
+        stress_test_reclamation<HazardPointerReclaimer>(seconds, threads);
+        stress_test_reclamation<EpochReclaimer>(seconds, threads);
+    }
+    
     // Memory ordering demonstrations
     demonstrate_memory_ordering();
     
@@ -785,7 +1998,7 @@ Lock-Free Programming:
 - Uses atomic operations instead of locks
 - Compare-and-swap (CAS) operations
 - Memory ordering guarantees
-- ABA problem prevention
+- ABA problem prevention (via safe memory reclamation)
 
 Atomic Operations:
 - Hardware-level synchronization
@@ -801,20 +2014,29 @@ Memory Ordering:
 
 Data Structures Implemented:
 
+0. Safe Memory Reclamation (Reclaimer policy template parameter):
+- HazardPointerReclaimer: threads publish pointers they dereference;
+  retired nodes are freed by scans that find them unprotected
+- EpochReclaimer: threads announce the global epoch per operation;
+  garbage is freed two epochs later
+- Exiting threads hand leftover garbage to an orphan list
+
 1. Lock-Free Stack:
 - Uses atomic pointer swapping
 - LIFO ordering maintained
-- ABA problem handled by immediate deletion
+- Popped nodes are retired, not deleted, so no use-after-free or ABA
 
 2. Lock-Free Queue (FIFO):
 - Michael & Scott algorithm
-- Separate head/tail pointers
-- Handles concurrent enqueue/dequeue
+- Separate head/tail pointers, lagging tail is helped forward
+- Old dummy nodes are retired through the Reclaimer
 
-3. Lock-Free Hash Map:
-- Chaining for collision resolution
-- Lazy deletion marking
-- Atomic key-value operations
+3. Lock-Free Hash Map (split-ordered list):
+- One Harris-Michael list sorted by bit-reversed hash; buckets are
+  lazily created dummy nodes pointing into it
+- Bucket count doubles online without moving any entry
+- Keys immutable per node, values swapped atomically by insert_or_assign
+- erase marks, unlinks and retires the node (memory stays bounded)
 
 4. Atomic Shared Pointer:
 - Reference counting with atomics
@@ -825,6 +2047,13 @@ Data Structures Implemented:
 - Single producer, single consumer
 - Power-of-2 sizing for efficiency
 - Memory ordering for synchronization
+- Read/write cursors on separate cache lines
+
+6. MPMC Ring Buffer (Vyukov):
+- Per-slot sequence numbers, one CAS per operation
+- Cache-line padded enqueue/dequeue cursors
+- try_push_n/try_pop_n claim a run of slots with one CAS
+- Blocking push/pop spin, then park with std::atomic::wait (futex)
 
 Performance Characteristics:
 
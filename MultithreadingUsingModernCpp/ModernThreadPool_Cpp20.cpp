@@ -18,31 +18,683 @@
 #include <latch>
 #include <barrier>
 #include <stop_token>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <cstdint>
+#include <bit>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <tuple>
+#include <utility>
+#include <variant>
+#include <algorithm>
+#include <cassert>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+#include <iomanip>
+
+// Lock-free building blocks for work-stealing schedulers
+
+// Chase-Lev work-stealing deque (Le, Pop, Cohen, Zappa Nardelli - PPoPP 2013).
+// The owning worker pushes and pops at the bottom (LIFO) without locks;
+// any other thread may steal from the top (FIFO) with a single CAS.
+// T must be trivially copyable (we store task pointers).
+template<typename T>
+class ChaseLevDeque {
+    static_assert(std::is_trivially_copyable_v<T>, "ChaseLevDeque stores T in std::atomic");
+    
+private:
+    struct Array {
+        int64_t capacity;
+        int64_t mask;
+        std::unique_ptr<std::atomic<T>[]> buffer;
+        
+        explicit Array(int64_t cap)
+            : capacity(cap), mask(cap - 1), buffer(new std::atomic<T>[cap]) {}
+        
+        T get(int64_t i) const { return buffer[i & mask].load(std::memory_order_relaxed); }
+        void put(int64_t i, T value) { buffer[i & mask].store(value, std::memory_order_relaxed); }
+        
+        Array* grow(int64_t bottom, int64_t top) const {
+            Array* bigger = new Array(capacity * 2);
+            for (int64_t i = top; i != bottom; ++i) {
+                bigger->put(i, get(i));
+            }
+            return bigger;
+        }
+    };
+    
+    alignas(64) std::atomic<int64_t> top_{0};
+    alignas(64) std::atomic<int64_t> bottom_{0};
+    alignas(64) std::atomic<Array*> array_;
+    
+    // Retired arrays may still be read by a concurrent thief, so they are
+    // only freed with the deque itself (at most log2(max size) of them).
+    std::vector<std::unique_ptr<Array>> retired_;
+    
+public:
+    explicit ChaseLevDeque(int64_t initial_capacity = 256)
+        : array_(new Array(std::bit_ceil(static_cast<uint64_t>(initial_capacity)))) {}
+    
+    ~ChaseLevDeque() {
+        delete array_.load(std::memory_order_relaxed);
+    }
+    
+    ChaseLevDeque(const ChaseLevDeque&) = delete;
+    ChaseLevDeque& operator=(const ChaseLevDeque&) = delete;
+    
+    // Owner only
+    void push(T value) {
+        int64_t b = bottom_.load(std::memory_order_relaxed);
+        int64_t t = top_.load(std::memory_order_acquire);
+        Array* a = array_.load(std::memory_order_relaxed);
+        
+        if (b - t > a->capacity - 1) {
+            Array* bigger = a->grow(b, t);
+            retired_.emplace_back(a);
+            array_.store(bigger, std::memory_order_release);
+            a = bigger;
+        }
+        
+        a->put(b, value);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+    
+    // Owner only
+    std::optional<T> pop() {
+        int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+        Array* a = array_.load(std::memory_order_relaxed);
+        bottom_.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = top_.load(std::memory_order_relaxed);
+        
+        if (t > b) {
+            // Deque was empty
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return std::nullopt;
+        }
+        
+        T value = a->get(b);
+        if (t == b) {
+            // Last element: race against thieves for it
+            bool won = top_.compare_exchange_strong(t, t + 1,
+                std::memory_order_seq_cst, std::memory_order_relaxed);
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            if (!won) {
+                return std::nullopt;
+            }
+        }
+        return value;
+    }
+    
+    // Any thread
+    std::optional<T> steal() {
+        int64_t t = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t b = bottom_.load(std::memory_order_acquire);
+        
+        if (t >= b) {
+            return std::nullopt;
+        }
+        
+        Array* a = array_.load(std::memory_order_acquire);
+        T value = a->get(t);
+        if (!top_.compare_exchange_strong(t, t + 1,
+                std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return std::nullopt; // Lost the race to another thief or the owner
+        }
+        return value;
+    }
+    
+    bool empty() const {
+        return size() == 0;
+    }
+    
+    size_t size() const {
+        int64_t b = bottom_.load(std::memory_order_relaxed);
+        int64_t t = top_.load(std::memory_order_relaxed);
+        return b > t ? static_cast<size_t>(b - t) : 0;
+    }
+};
+
+// Eventcount: lets idle threads park without a mutex and lets producers skip
+// the wake-up syscall entirely when nobody is sleeping.
+//
+// Waiter:   key = prepare_wait(); if (recheck finds work) cancel_wait(); else commit_wait(key);
+// Notifier: publish work; notify_one();
+class EventCount {
+private:
+    alignas(64) std::atomic<uint32_t> epoch_{0};
+    alignas(64) std::atomic<uint32_t> waiters_{0};
+    
+public:
+    uint32_t prepare_wait() {
+        waiters_.fetch_add(1, std::memory_order_seq_cst);
+        return epoch_.load(std::memory_order_seq_cst);
+    }
+    
+    void cancel_wait() {
+        waiters_.fetch_sub(1, std::memory_order_seq_cst);
+    }
+    
+    void commit_wait(uint32_t key) {
+        epoch_.wait(key, std::memory_order_seq_cst);
+        waiters_.fetch_sub(1, std::memory_order_seq_cst);
+    }
+    
+    void notify_one() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters_.load(std::memory_order_seq_cst) != 0) {
+            epoch_.fetch_add(1, std::memory_order_seq_cst);
+            epoch_.notify_one();
+        }
+    }
+    
+    void notify_all() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        epoch_.fetch_add(1, std::memory_order_seq_cst);
+        epoch_.notify_all();
+    }
+};
+
+// Allocation-free task submission building blocks
+
+// Per-thread recycling pool for fixed-size blocks. A block freed on its
+// owner thread goes straight back on the owner's free list; a block freed
+// on another thread is pushed onto the owner's lock-free "remote" list,
+// which the owner reclaims in one exchange the next time it runs dry.
+// Steady-state submit/run cycles therefore never reach malloc.
+template<typename T>
+class RecyclingPool {
+private:
+    struct Cache;
+    
+    struct Block {
+        Cache* owner;
+        Block* next;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+    
+    struct Cache {
+        static constexpr size_t MAX_LOCAL = 4096;
+        
+        Block* local = nullptr;
+        size_t local_count = 0;
+        std::atomic<Block*> remote{nullptr};
+        std::atomic<size_t> refs{1};     // Owning thread + every live block
+        
+        // Marks the remote list once the owning thread has exited
+        static Block* closed() { return reinterpret_cast<Block*>(uintptr_t{1}); }
+        
+        void release() {
+            if (refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                delete this;
+            }
+        }
+        
+        static void destroy_block(Block* block) {
+            Cache* owner = block->owner;
+            delete block;
+            owner->release();
+        }
+        
+        void close() {
+            while (local) {
+                Block* next = local->next;
+                destroy_block(local);
+                local = next;
+            }
+            Block* pending = remote.exchange(closed(), std::memory_order_acq_rel);
+            while (pending) {
+                Block* next = pending->next;
+                destroy_block(pending);
+                pending = next;
+            }
+            release();
+        }
+    };
+    
+    struct ThreadCache {
+        Cache* cache = new Cache;
+        ~ThreadCache() { cache->close(); }
+    };
+    
+    static Cache& local_cache() {
+        thread_local ThreadCache holder;
+        return *holder.cache;
+    }
+    
+    static Block* block_of(void* p) {
+        return reinterpret_cast<Block*>(static_cast<unsigned char*>(p) - offsetof(Block, storage));
+    }
+    
+public:
+    static void* allocate() {
+        Cache& cache = local_cache();
+        
+        if (!cache.local) {
+            cache.local = cache.remote.exchange(nullptr, std::memory_order_acquire);
+            cache.local_count = 0;
+            for (Block* b = cache.local; b; b = b->next) ++cache.local_count;
+        }
+        
+        if (Block* block = cache.local) {
+            cache.local = block->next;
+            --cache.local_count;
+            return block->storage;
+        }
+        
+        Block* block = new Block;
+        block->owner = &cache;
+        cache.refs.fetch_add(1, std::memory_order_relaxed);
+        return block->storage;
+    }
+    
+    static void deallocate(void* p) {
+        Block* block = block_of(p);
+        Cache* owner = block->owner;
+        
+        if (owner == &local_cache()) {
+            if (owner->local_count >= Cache::MAX_LOCAL) {
+                Cache::destroy_block(block);
+                return;
+            }
+            block->next = owner->local;
+            owner->local = block;
+            ++owner->local_count;
+            return;
+        }
+        
+        // Cross-thread free: hand it back to the owner
+        Block* head = owner->remote.load(std::memory_order_relaxed);
+        do {
+            if (head == Cache::closed()) {
+                Cache::destroy_block(block);
+                return;
+            }
+            block->next = head;
+        } while (!owner->remote.compare_exchange_weak(head, block,
+                    std::memory_order_release, std::memory_order_relaxed));
+    }
+    
+    template<typename... Args>
+    static T* create(Args&&... args) {
+        void* memory = allocate();
+        try {
+            return ::new (memory) T(std::forward<Args>(args)...);
+        } catch (...) {
+            deallocate(memory);
+            throw;
+        }
+    }
+    
+    static void destroy(T* object) {
+        object->~T();
+        deallocate(object);
+    }
+};
+
+// Move-only type-erased callable with 64 bytes of inline storage.
+// Callables that fit are stored in place (no allocation); larger ones fall
+// back to the heap. Unlike std::function it accepts move-only captures.
+class InlineTask {
+public:
+    static constexpr size_t INLINE_SIZE = 64;
+    
+private:
+    struct VTable {
+        void (*invoke)(void* storage);
+        void (*move)(void* dst, void* src) noexcept;
+        void (*destroy)(void* storage) noexcept;
+    };
+    
+    template<typename F>
+    static constexpr bool fits_inline = sizeof(F) <= INLINE_SIZE &&
+                                        alignof(F) <= alignof(std::max_align_t) &&
+                                        std::is_nothrow_move_constructible_v<F>;
+    
+    template<typename F>
+    static constexpr VTable inline_vtable{
+        [](void* s) { (*static_cast<F*>(s))(); },
+        [](void* dst, void* src) noexcept {
+            ::new (dst) F(std::move(*static_cast<F*>(src)));
+            static_cast<F*>(src)->~F();
+        },
+        [](void* s) noexcept { static_cast<F*>(s)->~F(); }
+    };
+    
+    template<typename F>
+    static constexpr VTable heap_vtable{
+        [](void* s) { (**static_cast<F**>(s))(); },
+        [](void* dst, void* src) noexcept {
+            ::new (dst) F*(*static_cast<F**>(src));
+        },
+        [](void* s) noexcept { delete *static_cast<F**>(s); }
+    };
+    
+    alignas(std::max_align_t) unsigned char storage_[INLINE_SIZE];
+    const VTable* vtable_ = nullptr;
+    
+public:
+    InlineTask() = default;
+    
+    template<typename F, typename Fn = std::decay_t<F>,
+             typename = std::enable_if_t<!std::is_same_v<Fn, InlineTask>>>
+    InlineTask(F&& f) {
+        if constexpr (fits_inline<Fn>) {
+            ::new (storage_) Fn(std::forward<F>(f));
+            vtable_ = &inline_vtable<Fn>;
+        } else {
+            ::new (storage_) Fn*(new Fn(std::forward<F>(f)));
+            vtable_ = &heap_vtable<Fn>;
+        }
+    }
+    
+    InlineTask(InlineTask&& other) noexcept : vtable_(other.vtable_) {
+        if (vtable_) {
+            vtable_->move(storage_, other.storage_);
+            other.vtable_ = nullptr;
+        }
+    }
+    
+    InlineTask& operator=(InlineTask&& other) noexcept {
+        if (this != &other) {
+            reset();
+            if (other.vtable_) {
+                other.vtable_->move(storage_, other.storage_);
+                vtable_ = std::exchange(other.vtable_, nullptr);
+            }
+        }
+        return *this;
+    }
+    
+    InlineTask(const InlineTask&) = delete;
+    InlineTask& operator=(const InlineTask&) = delete;
+    
+    ~InlineTask() {
+        reset();
+    }
+    
+    void operator()() {
+        vtable_->invoke(storage_);
+    }
+    
+    explicit operator bool() const {
+        return vtable_ != nullptr;
+    }
+    
+    void reset() {
+        if (vtable_) {
+            vtable_->destroy(storage_);
+            vtable_ = nullptr;
+        }
+    }
+};
+
+// Shared state for TaskFuture<T>, recycled through RecyclingPool instead of
+// the one-allocation-per-call std::promise/std::future pair.
+template<typename T>
+class TaskState {
+private:
+    using value_type = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+    
+    enum : uint32_t { PENDING = 0, READY = 1, PENDING_WITH_WAITER = 2 };
+    
+    std::atomic<uint32_t> status_{PENDING};
+    std::atomic<uint32_t> refs_{2};          // One for the promise, one for the future
+    std::optional<value_type> value_;
+    std::exception_ptr error_;
+    
+    void publish() {
+        // Only issue a futex wake when the future is actually blocked
+        if (status_.exchange(READY, std::memory_order_acq_rel) == PENDING_WITH_WAITER) {
+            status_.notify_all();
+        }
+    }
+    
+public:
+    static TaskState* create() {
+        return RecyclingPool<TaskState>::create();
+    }
+    
+    void release() {
+        if (refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            RecyclingPool<TaskState>::destroy(this);
+        }
+    }
+    
+    template<typename... V>
+    void set_value(V&&... v) {
+        value_.emplace(std::forward<V>(v)...);
+        publish();
+    }
+    
+    void set_exception(std::exception_ptr e) {
+        error_ = std::move(e);
+        publish();
+    }
+    
+    bool is_ready() const {
+        return status_.load(std::memory_order_acquire) == READY;
+    }
+    
+    void wait() {
+        uint32_t status = status_.load(std::memory_order_acquire);
+        if (status == READY) return;
+        
+        if (status == PENDING) {
+            status_.compare_exchange_strong(status, PENDING_WITH_WAITER, std::memory_order_acq_rel);
+        }
+        while (status_.load(std::memory_order_acquire) != READY) {
+            status_.wait(PENDING_WITH_WAITER, std::memory_order_acquire);
+        }
+    }
+    
+    T get() {
+        wait();
+        if (error_) {
+            std::rethrow_exception(error_);
+        }
+        if constexpr (!std::is_void_v<T>) {
+            return std::move(*value_);
+        }
+    }
+};
+
+// Producer side, owned by the queued task. Breaks the promise if the task
+// is dropped without running (e.g. during shutdown).
+template<typename T>
+class TaskPromise {
+private:
+    TaskState<T>* state_;
+    
+public:
+    explicit TaskPromise(TaskState<T>* state) : state_(state) {}
+    TaskPromise(TaskPromise&& other) noexcept : state_(std::exchange(other.state_, nullptr)) {}
+    TaskPromise(const TaskPromise&) = delete;
+    TaskPromise& operator=(const TaskPromise&) = delete;
+    TaskPromise& operator=(TaskPromise&&) = delete;
+    
+    ~TaskPromise() {
+        if (state_) {
+            state_->set_exception(std::make_exception_ptr(
+                std::future_error(std::future_errc::broken_promise)));
+            state_->release();
+        }
+    }
+    
+    template<typename F, typename Tuple>
+    void run(F& f, Tuple& args) {
+        try {
+            if constexpr (std::is_void_v<T>) {
+                std::apply(f, std::move(args));
+                state_->set_value();
+            } else {
+                state_->set_value(std::apply(f, std::move(args)));
+            }
+        } catch (...) {
+            state_->set_exception(std::current_exception());
+        }
+        std::exchange(state_, nullptr)->release();
+    }
+};
+
+// Consumer side returned by ModernThreadPool::submit
+template<typename T>
+class TaskFuture {
+private:
+    TaskState<T>* state_ = nullptr;
+    
+public:
+    TaskFuture() = default;
+    explicit TaskFuture(TaskState<T>* state) : state_(state) {}
+    TaskFuture(TaskFuture&& other) noexcept : state_(std::exchange(other.state_, nullptr)) {}
+    
+    TaskFuture& operator=(TaskFuture&& other) noexcept {
+        if (this != &other) {
+            if (state_) state_->release();
+            state_ = std::exchange(other.state_, nullptr);
+        }
+        return *this;
+    }
+    
+    TaskFuture(const TaskFuture&) = delete;
+    TaskFuture& operator=(const TaskFuture&) = delete;
+    
+    ~TaskFuture() {
+        if (state_) state_->release();
+    }
+    
+    bool valid() const { return state_ != nullptr; }
+    bool is_ready() const { return state_->is_ready(); }
+    void wait() const { state_->wait(); }
+    
+    // Single-shot, like std::future::get()
+    T get() {
+        TaskState<T>* state = std::exchange(state_, nullptr);
+        struct Releaser {
+            TaskState<T>* s;
+            ~Releaser() { s->release(); }
+        } releaser{state};
+        return state->get();
+    }
+};
 
 // 1. Modern Thread Pool with C++20 features
 class ModernThreadPool {
+public:
+    // GlobalQueue:  one mutex-protected FIFO shared by all workers
+    // WorkStealing: one Chase-Lev deque per worker, random-victim stealing,
+    //               idle workers park on an eventcount
+    enum class Mode { GlobalQueue, WorkStealing };
+    
 private:
+    // Queued unit of work; nodes are recycled, so the hot path never allocates
+    struct JobNode {
+        InlineTask task;
+        JobNode* next = nullptr;
+        
+        explicit JobNode(InlineTask&& t) : task(std::move(t)) {}
+    };
+    using Job = JobNode;
+    
+    // Intrusive FIFO of JobNodes (caller provides locking)
+    class JobQueue {
+    private:
+        JobNode* head_ = nullptr;
+        JobNode* tail_ = nullptr;
+        size_t size_ = 0;
+        
+    public:
+        bool empty() const { return head_ == nullptr; }
+        size_t size() const { return size_; }
+        
+        void push(JobNode* node) {
+            node->next = nullptr;
+            if (tail_) tail_->next = node; else head_ = node;
+            tail_ = node;
+            ++size_;
+        }
+        
+        JobNode* pop() {
+            JobNode* node = head_;
+            if (node) {
+                head_ = node->next;
+                if (!head_) tail_ = nullptr;
+                --size_;
+            }
+            return node;
+        }
+    };
+    
+    static JobNode* make_job(InlineTask&& task) {
+        return RecyclingPool<JobNode>::create(std::move(task));
+    }
+    
+    static void free_job(JobNode* job) {
+        RecyclingPool<JobNode>::destroy(job);
+    }
+    
+    struct alignas(64) StealingWorker {
+        ChaseLevDeque<Job*> deque;
+        uint64_t rng_state;
+    };
+    
+    Mode mode_;
     std::vector<std::jthread> workers_;
-    std::queue<std::function<void()>> tasks_;
-    std::mutex queue_mutex_;
+    JobQueue tasks_;
+    mutable std::mutex queue_mutex_;
     std::condition_variable_any condition_;
     std::stop_source stop_source_;
     std::atomic<size_t> active_tasks_{0};
     std::atomic<size_t> completed_tasks_{0};
     
+    // WorkStealing mode state
+    std::vector<std::unique_ptr<StealingWorker>> stealing_workers_;
+    JobQueue injector_;                          // Submissions from non-worker threads
+    std::atomic<size_t> injector_size_{0};
+    EventCount idle_;
+    std::atomic<size_t> outstanding_{0};         // Submitted but not yet finished
+    
+    static inline thread_local ModernThreadPool* current_pool_ = nullptr;
+    static inline thread_local size_t current_worker_ = 0;
+    
 public:
-    explicit ModernThreadPool(size_t num_threads = std::thread::hardware_concurrency())
-        : workers_() {
+    explicit ModernThreadPool(size_t num_threads = std::thread::hardware_concurrency(),
+                              Mode mode = Mode::GlobalQueue)
+        : mode_(mode), workers_() {
         
         workers_.reserve(num_threads);
         
+        if (mode_ == Mode::WorkStealing) {
+            stealing_workers_.reserve(num_threads);
+            for (size_t i = 0; i < num_threads; ++i) {
+                auto worker = std::make_unique<StealingWorker>();
+                worker->rng_state = 0x9E3779B97F4A7C15ULL * (i + 1);
+                stealing_workers_.push_back(std::move(worker));
+            }
+        }
+        
         for (size_t i = 0; i < num_threads; ++i) {
-            workers_.emplace_back([this](std::stop_token stoken) {
-                worker_loop(stoken);
+            workers_.emplace_back([this, i](std::stop_token stoken) {
+                if (mode_ == Mode::WorkStealing) {
+                    stealing_worker_loop(i, stoken);
+                } else {
+                    worker_loop(stoken);
+                }
             });
         }
         
-        std::cout << "ModernThreadPool created with " << num_threads << " threads" << std::endl;
+        std::cout << "ModernThreadPool created with " << num_threads << " threads ("
+                  << (mode_ == Mode::WorkStealing ? "work-stealing" : "global queue") << ")" << std::endl;
     }
     
     ~ModernThreadPool() {
@@ -53,40 +705,67 @@ public:
         
         // Wake up all waiting workers
         condition_.notify_all();
+        idle_.notify_all();
+        
+        // Join before the queues the workers use are destroyed
+        workers_.clear();
+        
+        // Free anything left behind in work-stealing mode
+        for (auto& worker : stealing_workers_) {
+            while (auto job = worker->deque.pop()) {
+                free_job(*job);
+            }
+        }
+        while (JobNode* job = injector_.pop()) {
+            free_job(job);
+        }
+        while (JobNode* job = tasks_.pop()) {
+            free_job(job);
+        }
         
-        // jthread automatically joins in destructor
         std::cout << "ModernThreadPool destroyed. Completed " << completed_tasks_.load() << " tasks." << std::endl;
     }
     
-    // Submit a task and return a future
+    // Submit a task and return a future. The callable, its arguments and the
+    // promise are stored inline in a recycled job node, and the future's
+    // shared state comes from a per-thread free list, so steady-state
+    // submission performs no heap allocation.
     template<typename F, typename... Args>
-    auto submit(F&& f, Args&&... args) -> std::future<std::invoke_result_t<F, Args...>> {
-        using return_type = std::invoke_result_t<F, Args...>;
-        
-        // Create a packaged_task for the function call
-        auto task = std::make_shared<std::packaged_task<return_type()>>(
-            std::bind(std::forward<F>(f), std::forward<Args>(args)...)
-        );
+    auto submit(F&& f, Args&&... args) -> TaskFuture<std::invoke_result_t<std::decay_t<F>&, std::decay_t<Args>...>> {
+        using return_type = std::invoke_result_t<std::decay_t<F>&, std::decay_t<Args>...>;
         
-        std::future<return_type> result = task->get_future();
+        TaskState<return_type>* state = TaskState<return_type>::create();
+        TaskFuture<return_type> result(state);
         
-        {
-            std::unique_lock lock(queue_mutex_);
-            
-            // Don't accept new tasks if stopping
-            if (stop_source_.stop_requested()) {
-                throw std::runtime_error("ThreadPool is shutting down");
-            }
-            
-            tasks_.emplace([task]() {
-                (*task)();
-            });
-        }
+        enqueue(InlineTask(
+            [promise = TaskPromise<return_type>(state),
+             fn = std::forward<F>(f),
+             bound = std::make_tuple(std::forward<Args>(args)...)]() mutable {
+                promise.run(fn, bound);
+            }));
         
-        condition_.notify_one();
         return result;
     }
     
+    // Fire-and-forget submission: no future, no shared state. Exceptions are
+    // reported by the worker like any other task exception.
+    template<typename F, typename... Args>
+    void post(F&& f, Args&&... args) {
+        if constexpr (sizeof...(Args) == 0) {
+            enqueue(InlineTask(std::forward<F>(f)));
+        } else {
+            enqueue(InlineTask(
+                [fn = std::forward<F>(f),
+                 bound = std::make_tuple(std::forward<Args>(args)...)]() mutable {
+                    std::apply(fn, std::move(bound));
+                }));
+        }
+    }
+    
+    Mode mode() const {
+        return mode_;
+    }
+    
     // Get number of active tasks
     size_t active_tasks() const {
         return active_tasks_.load();
@@ -99,12 +778,29 @@ public:
     
     // Get number of pending tasks
     size_t pending_tasks() const {
+        if (mode_ == Mode::WorkStealing) {
+            size_t pending = injector_size_.load();
+            for (const auto& worker : stealing_workers_) {
+                pending += worker->deque.size();
+            }
+            return pending;
+        }
+        
         std::unique_lock lock(queue_mutex_);
         return tasks_.size();
     }
     
     // Wait for all current tasks to complete
     void wait_for_completion() {
+        if (mode_ == Mode::WorkStealing) {
+            size_t remaining = outstanding_.load();
+            while (remaining != 0) {
+                outstanding_.wait(remaining);
+                remaining = outstanding_.load();
+            }
+            return;
+        }
+        
         std::unique_lock lock(queue_mutex_);
         condition_.wait(lock, [this]() {
             return tasks_.empty() && active_tasks_.load() == 0;
@@ -112,9 +808,32 @@ public:
     }
     
 private:
+    void enqueue(InlineTask&& task) {
+        JobNode* job = make_job(std::move(task));
+        
+        if (mode_ == Mode::WorkStealing) {
+            enqueue_stealing(job);
+            return;
+        }
+        
+        {
+            std::unique_lock lock(queue_mutex_);
+            
+            // Don't accept new tasks if stopping
+            if (stop_source_.stop_requested()) {
+                free_job(job);
+                throw std::runtime_error("ThreadPool is shutting down");
+            }
+            
+            tasks_.push(job);
+        }
+        
+        condition_.notify_one();
+    }
+    
     void worker_loop(std::stop_token stoken) {
         while (!stoken.stop_requested()) {
-            std::function<void()> task;
+            JobNode* task = nullptr;
             
             {
                 std::unique_lock lock(queue_mutex_);
@@ -129,27 +848,147 @@ private:
                 }
                 
                 if (!tasks_.empty()) {
-                    task = std::move(tasks_.front());
-                    tasks_.pop();
+                    task = tasks_.pop();
                     ++active_tasks_;
                 }
             }
             
             if (task) {
                 try {
-                    task();
+                    task->task();
                 } catch (const std::exception& e) {
                     std::cerr << "Task threw exception: " << e.what() << std::endl;
                 } catch (...) {
                     std::cerr << "Task threw unknown exception" << std::endl;
                 }
+                free_job(task);
                 
                 --active_tasks_;
                 ++completed_tasks_;
+                
+                // Pulse the mutex so a waiter between its predicate check and
+                // its sleep cannot miss this notification
+                { std::lock_guard lock(queue_mutex_); }
                 condition_.notify_all(); // Notify wait_for_completion
             }
         }
     }
+    
+    // Tasks submitted from one of our own workers go to that worker's deque;
+    // everything else goes through the (rarely contended) injector queue.
+    void enqueue_stealing(JobNode* job) {
+        outstanding_.fetch_add(1, std::memory_order_relaxed);
+        
+        if (current_pool_ == this) {
+            stealing_workers_[current_worker_]->deque.push(job);
+        } else {
+            std::lock_guard lock(queue_mutex_);
+            if (stop_source_.stop_requested()) {
+                free_job(job);
+                outstanding_.fetch_sub(1, std::memory_order_relaxed);
+                throw std::runtime_error("ThreadPool is shutting down");
+            }
+            injector_.push(job);
+            injector_size_.fetch_add(1, std::memory_order_release);
+        }
+        
+        idle_.notify_one();
+    }
+    
+    Job* find_job(size_t worker_id) {
+        StealingWorker& self = *stealing_workers_[worker_id];
+        
+        // 1. Own deque, LIFO for cache locality
+        if (auto job = self.deque.pop()) {
+            return *job;
+        }
+        
+        // 2. External submissions
+        if (injector_size_.load(std::memory_order_acquire) != 0) {
+            std::lock_guard lock(queue_mutex_);
+            if (!injector_.empty()) {
+                Job* job = injector_.pop();
+                injector_size_.fetch_sub(1, std::memory_order_relaxed);
+                return job;
+            }
+        }
+        
+        // 3. Steal from random victims
+        const size_t n = stealing_workers_.size();
+        if (n > 1) {
+            for (size_t attempt = 0; attempt < 2 * n; ++attempt) {
+                // xorshift64
+                uint64_t& x = self.rng_state;
+                x ^= x << 13;
+                x ^= x >> 7;
+                x ^= x << 17;
+                size_t victim = static_cast<size_t>(x % n);
+                if (victim == worker_id) continue;
+                
+                if (auto job = stealing_workers_[victim]->deque.steal()) {
+                    return *job;
+                }
+            }
+        }
+        
+        return nullptr;
+    }
+    
+    void run_job(Job* job) {
+        ++active_tasks_;
+        try {
+            job->task();
+        } catch (const std::exception& e) {
+            std::cerr << "Task threw exception: " << e.what() << std::endl;
+        } catch (...) {
+            std::cerr << "Task threw unknown exception" << std::endl;
+        }
+        free_job(job);
+        --active_tasks_;
+        ++completed_tasks_;
+        
+        // Only touch the futex when the very last outstanding task finishes
+        if (outstanding_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            outstanding_.notify_all();
+        }
+    }
+    
+    void stealing_worker_loop(size_t worker_id, std::stop_token stoken) {
+        current_pool_ = this;
+        current_worker_ = worker_id;
+        
+        constexpr int SPIN_ROUNDS = 64;
+        
+        while (true) {
+            Job* job = nullptr;
+            
+            // Spin briefly before parking
+            for (int spin = 0; spin < SPIN_ROUNDS && !job; ++spin) {
+                job = find_job(worker_id);
+                if (!job) std::this_thread::yield();
+            }
+            
+            if (job) {
+                run_job(job);
+                continue;
+            }
+            
+            // Park: recheck after announcing ourselves so no wake-up is lost
+            uint32_t key = idle_.prepare_wait();
+            if ((job = find_job(worker_id)) != nullptr) {
+                idle_.cancel_wait();
+                run_job(job);
+                continue;
+            }
+            if (stoken.stop_requested()) {
+                idle_.cancel_wait();
+                break;
+            }
+            idle_.commit_wait(key);
+        }
+        
+        current_pool_ = nullptr;
+    }
 };
 
 // 2. Priority Thread Pool with semaphore-based resource management
@@ -268,29 +1107,160 @@ private:
     }
 };
 
+// CPU topology from /sys/devices/system/cpu, used for locality-aware stealing.
+// Falls back to "one flat domain" when sysfs is unavailable.
+struct CpuTopology {
+    struct Cpu {
+        int id;
+        int numa_node;
+        int l3_domain;   // Lowest CPU id sharing this CPU's L3 (or -1)
+    };
+    
+    std::vector<Cpu> cpus;
+    
+    static CpuTopology detect() {
+        namespace fs = std::filesystem;
+        CpuTopology topology;
+        const fs::path root = "/sys/devices/system/cpu";
+        
+        std::error_code ec;
+        for (const auto& entry : fs::directory_iterator(root, ec)) {
+            const std::string name = entry.path().filename().string();
+            if (name.size() <= 3 || name.compare(0, 3, "cpu") != 0 ||
+                !std::all_of(name.begin() + 3, name.end(), ::isdigit)) {
+                continue;
+            }
+            
+            Cpu cpu{std::stoi(name.substr(3)), 0, -1};
+            
+            // Skip offline CPUs
+            std::ifstream online(entry.path() / "online");
+            int is_online = 1;
+            if (online && online >> is_online && !is_online) continue;
+            
+            // NUMA node appears as a "nodeN" link inside the cpu directory
+            for (const auto& sub : fs::directory_iterator(entry.path(), ec)) {
+                const std::string sub_name = sub.path().filename().string();
+                if (sub_name.size() > 4 && sub_name.compare(0, 4, "node") == 0 &&
+                    std::all_of(sub_name.begin() + 4, sub_name.end(), ::isdigit)) {
+                    cpu.numa_node = std::stoi(sub_name.substr(4));
+                }
+            }
+            
+            // L3 domain: first CPU in the level-3 cache's shared_cpu_list
+            for (const auto& cache : fs::directory_iterator(entry.path() / "cache", ec)) {
+                std::ifstream level_file(cache.path() / "level");
+                int level = 0;
+                if (!(level_file >> level) || level != 3) continue;
+                
+                std::ifstream shared(cache.path() / "shared_cpu_list");
+                int first = -1;
+                if (shared >> first) cpu.l3_domain = first;
+            }
+            
+            topology.cpus.push_back(cpu);
+        }
+        
+        if (topology.cpus.empty()) {
+            unsigned n = std::max(1u, std::thread::hardware_concurrency());
+            for (unsigned i = 0; i < n; ++i) {
+                topology.cpus.push_back({static_cast<int>(i), 0, -1});
+            }
+        }
+        
+        std::sort(topology.cpus.begin(), topology.cpus.end(),
+                  [](const Cpu& a, const Cpu& b) { return a.id < b.id; });
+        return topology;
+    }
+};
+
 // 3. Work-Stealing Thread Pool (advanced concept)
+//
+// - Owner pushes/pops its own Chase-Lev deque LIFO without locks; thieves
+//   take the oldest (largest) work FIFO from the other end.
+// - Workers are pinned round-robin over the online CPUs; each worker steals
+//   first from workers sharing its L3, then its NUMA node, then anywhere.
+// - Idle workers spin with exponential backoff, then park on an eventcount.
+// - spawn()/sync() give fork/join on top of the deques for recursive
+//   divide-and-conquer; a syncing worker keeps running tasks meanwhile.
 class WorkStealingThreadPool {
+public:
+    // Counts outstanding spawned children; sync() waits for it to drain
+    class TaskGroup {
+    private:
+        friend class WorkStealingThreadPool;
+        std::atomic<size_t> pending_{0};
+        
+    public:
+        TaskGroup() = default;
+        TaskGroup(const TaskGroup&) = delete;
+        TaskGroup& operator=(const TaskGroup&) = delete;
+        
+        ~TaskGroup() {
+            assert(pending_.load() == 0 && "TaskGroup destroyed before sync()");
+        }
+    };
+    
 private:
-    struct WorkerData {
-        std::queue<std::function<void()>> local_queue;
-        std::mutex local_mutex;
-        std::atomic<size_t> work_count{0};
+    struct Job {
+        InlineTask task;
+        explicit Job(InlineTask&& t) : task(std::move(t)) {}
+    };
+    
+    struct alignas(64) WorkerData {
+        ChaseLevDeque<Job*> deque;
+        std::vector<size_t> near_victims;   // Same L3 domain
+        std::vector<size_t> node_victims;   // Same NUMA node, different L3
+        std::vector<size_t> far_victims;    // Everyone else
+        uint64_t rng_state = 0;
+        int cpu = -1;
     };
     
     std::vector<std::jthread> workers_;
     std::vector<std::unique_ptr<WorkerData>> worker_data_;
     std::atomic<bool> stopping_{false};
-    std::atomic<size_t> global_work_count_{0};
-    std::condition_variable_any work_available_;
-    std::mutex global_mutex_;
+    
+    // Submissions from non-worker threads
+    std::mutex injector_mutex_;
+    std::queue<Job*> injector_;
+    std::atomic<size_t> injector_size_{0};
+    
+    EventCount idle_;
+    
+    static inline thread_local WorkStealingThreadPool* current_pool_ = nullptr;
+    static inline thread_local size_t current_worker_ = 0;
     
 public:
     explicit WorkStealingThreadPool(size_t num_threads = std::thread::hardware_concurrency()) {
         worker_data_.reserve(num_threads);
         workers_.reserve(num_threads);
         
+        const CpuTopology topology = CpuTopology::detect();
+        
+        for (size_t i = 0; i < num_threads; ++i) {
+            auto data = std::make_unique<WorkerData>();
+            data->rng_state = 0x9E3779B97F4A7C15ULL * (i + 1);
+            data->cpu = topology.cpus[i % topology.cpus.size()].id;
+            worker_data_.push_back(std::move(data));
+        }
+        
+        // Build per-worker victim tiers from the CPU each worker is pinned to
+        for (size_t i = 0; i < num_threads; ++i) {
+            const auto& me = topology.cpus[i % topology.cpus.size()];
+            for (size_t j = 0; j < num_threads; ++j) {
+                if (j == i) continue;
+                const auto& other = topology.cpus[j % topology.cpus.size()];
+                if (me.l3_domain >= 0 && me.l3_domain == other.l3_domain) {
+                    worker_data_[i]->near_victims.push_back(j);
+                } else if (me.numa_node == other.numa_node) {
+                    worker_data_[i]->node_victims.push_back(j);
+                } else {
+                    worker_data_[i]->far_victims.push_back(j);
+                }
+            }
+        }
+        
         for (size_t i = 0; i < num_threads; ++i) {
-            worker_data_.emplace_back(std::make_unique<WorkerData>());
             workers_.emplace_back([this, i](std::stop_token stoken) {
                 worker_loop(i, stoken);
             });
@@ -301,101 +1271,306 @@ public:
     
     ~WorkStealingThreadPool() {
         stopping_ = true;
-        work_available_.notify_all();
         
         for (auto& worker : workers_) {
             worker.request_stop();
         }
+        idle_.notify_all();
+        workers_.clear();
+        
+        for (auto& data : worker_data_) {
+            while (auto job = data->deque.pop()) {
+                RecyclingPool<Job>::destroy(*job);
+            }
+        }
+        while (!injector_.empty()) {
+            RecyclingPool<Job>::destroy(injector_.front());
+            injector_.pop();
+        }
     }
     
     template<typename F, typename... Args>
-    auto submit(F&& f, Args&&... args) -> std::future<std::invoke_result_t<F, Args...>> {
-        using return_type = std::invoke_result_t<F, Args...>;
+    auto submit(F&& f, Args&&... args) -> TaskFuture<std::invoke_result_t<std::decay_t<F>&, std::decay_t<Args>...>> {
+        using return_type = std::invoke_result_t<std::decay_t<F>&, std::decay_t<Args>...>;
         
-        auto task = std::make_shared<std::packaged_task<return_type()>>(
-            std::bind(std::forward<F>(f), std::forward<Args>(args)...)
-        );
+        TaskState<return_type>* state = TaskState<return_type>::create();
+        TaskFuture<return_type> result(state);
         
-        std::future<return_type> result = task->get_future();
+        push(InlineTask(
+            [promise = TaskPromise<return_type>(state),
+             fn = std::forward<F>(f),
+             bound = std::make_tuple(std::forward<Args>(args)...)]() mutable {
+                promise.run(fn, bound);
+            }));
         
-        // Find worker with least work
-        size_t best_worker = 0;
-        size_t min_work = worker_data_[0]->work_count.load();
+        return result;
+    }
+    
+    // Fork: run f asynchronously as a child of group. From a worker thread
+    // the child goes onto that worker's own deque.
+    template<typename F>
+    void spawn(TaskGroup& group, F&& f) {
+        group.pending_.fetch_add(1, std::memory_order_relaxed);
+        push(InlineTask([&group, fn = std::forward<F>(f)]() mutable {
+            struct Done {
+                TaskGroup& g;
+                ~Done() {
+                    if (g.pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                        g.pending_.notify_all();
+                    }
+                }
+            } done{group};
+            fn();
+        }));
+    }
+    
+    // Join: wait for every child spawned into group. A worker keeps executing
+    // other tasks (its own first, then stolen ones) while it waits, so nested
+    // fork/join never deadlocks the pool.
+    void sync(TaskGroup& group) {
+        const bool on_worker = current_pool_ == this;
+        int idle_rounds = 0;
         
-        for (size_t i = 1; i < worker_data_.size(); ++i) {
-            size_t work = worker_data_[i]->work_count.load();
-            if (work < min_work) {
-                min_work = work;
-                best_worker = i;
+        while (true) {
+            size_t pending = group.pending_.load(std::memory_order_acquire);
+            if (pending == 0) return;
+            
+            if (Job* job = find_job(on_worker ? current_worker_ : SIZE_MAX)) {
+                run_job(job);
+                idle_rounds = 0;
+                continue;
+            }
+            
+            if (on_worker || ++idle_rounds < 64) {
+                backoff(idle_rounds);
+            } else {
+                // External thread with nothing to steal: block until the group drains
+                group.pending_.wait(pending, std::memory_order_acquire);
             }
         }
+    }
+    
+    size_t size() const {
+        return workers_.size();
+    }
+    
+private:
+    void push(InlineTask&& task) {
+        Job* job = RecyclingPool<Job>::create(std::move(task));
         
-        {
-            std::lock_guard lock(worker_data_[best_worker]->local_mutex);
-            worker_data_[best_worker]->local_queue.emplace([task]() {
-                (*task)();
-            });
-            ++worker_data_[best_worker]->work_count;
-            ++global_work_count_;
+        if (current_pool_ == this) {
+            worker_data_[current_worker_]->deque.push(job);
+        } else {
+            std::lock_guard lock(injector_mutex_);
+            injector_.push(job);
+            injector_size_.fetch_add(1, std::memory_order_release);
         }
         
-        work_available_.notify_one();
-        return result;
+        idle_.notify_one();
+    }
+    
+    // xorshift64
+    static size_t random_start(uint64_t& rng, size_t n) {
+        rng ^= rng << 13;
+        rng ^= rng >> 7;
+        rng ^= rng << 17;
+        return static_cast<size_t>(rng % n);
+    }
+    
+    Job* steal_from(const std::vector<size_t>& victims, uint64_t& rng) {
+        const size_t n = victims.size();
+        if (n == 0) return nullptr;
+        
+        // Random starting point, then sweep the tier once
+        size_t start = random_start(rng, n);
+        for (size_t k = 0; k < n; ++k) {
+            if (auto job = worker_data_[victims[(start + k) % n]]->deque.steal()) {
+                return *job;
+            }
+        }
+        return nullptr;
+    }
+    
+    // Same sweep over every worker, for threads that have no victim tiers
+    Job* steal_from_any(uint64_t& rng) {
+        const size_t n = worker_data_.size();
+        if (n == 0) return nullptr;
+        
+        size_t start = random_start(rng, n);
+        for (size_t k = 0; k < n; ++k) {
+            if (auto job = worker_data_[(start + k) % n]->deque.steal()) {
+                return *job;
+            }
+        }
+        return nullptr;
+    }
+    
+    // worker_id == SIZE_MAX means "called from a non-worker thread"
+    Job* find_job(size_t worker_id) {
+        if (worker_id != SIZE_MAX) {
+            WorkerData& self = *worker_data_[worker_id];
+            
+            // 1. Own deque (LIFO: hottest data in cache)
+            if (auto job = self.deque.pop()) {
+                return *job;
+            }
+        }
+        
+        // 2. External submissions
+        if (injector_size_.load(std::memory_order_acquire) != 0) {
+            std::lock_guard lock(injector_mutex_);
+            if (!injector_.empty()) {
+                Job* job = injector_.front();
+                injector_.pop();
+                injector_size_.fetch_sub(1, std::memory_order_relaxed);
+                return job;
+            }
+        }
+        
+        // 3. Steal, nearest victims first
+        if (worker_id != SIZE_MAX) {
+            WorkerData& self = *worker_data_[worker_id];
+            if (Job* job = steal_from(self.near_victims, self.rng_state)) return job;
+            if (Job* job = steal_from(self.node_victims, self.rng_state)) return job;
+            if (Job* job = steal_from(self.far_victims, self.rng_state)) return job;
+        } else {
+            thread_local uint64_t external_rng = 0x2545F4914F6CDD1DULL;
+            return steal_from_any(external_rng);
+        }
+        
+        return nullptr;
+    }
+    
+    void run_job(Job* job) {
+        try {
+            job->task();
+        } catch (const std::exception& e) {
+            std::cerr << "Work stealing task exception: " << e.what() << std::endl;
+        }
+        RecyclingPool<Job>::destroy(job);
+    }
+    
+    // Exponential backoff: a few busy-wait rounds, then yield
+    static void backoff(int round) {
+        if (round < 6) {
+            for (int i = 0; i < (1 << round); ++i) {
+#if defined(__x86_64__) || defined(__i386__)
+                __builtin_ia32_pause();
+#else
+                std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+            }
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    
+    static void pin_to_cpu([[maybe_unused]] int cpu) {
+#ifdef __linux__
+        if (cpu < 0) return;
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set); // Best effort
+#endif
     }
     
-private:
     void worker_loop(size_t worker_id, std::stop_token stoken) {
-        WorkerData& my_data = *worker_data_[worker_id];
+        current_pool_ = this;
+        current_worker_ = worker_id;
+        pin_to_cpu(worker_data_[worker_id]->cpu);
         
-        while (!stoken.stop_requested()) {
-            std::function<void()> task;
+        constexpr int MAX_IDLE_ROUNDS = 16;
+        
+        while (true) {
+            Job* job = nullptr;
             
-            // Try to get work from local queue
-            {
-                std::lock_guard lock(my_data.local_mutex);
-                if (!my_data.local_queue.empty()) {
-                    task = std::move(my_data.local_queue.front());
-                    my_data.local_queue.pop();
-                    --my_data.work_count;
-                    --global_work_count_;
-                }
+            for (int round = 0; round < MAX_IDLE_ROUNDS; ++round) {
+                if ((job = find_job(worker_id)) != nullptr) break;
+                backoff(round);
             }
             
-            // If no local work, try to steal from other workers
-            if (!task) {
-                for (size_t i = 0; i < worker_data_.size(); ++i) {
-                    if (i == worker_id) continue;
-                    
-                    WorkerData& other_data = *worker_data_[i];
-                    std::lock_guard lock(other_data.local_mutex);
-                    
-                    if (!other_data.local_queue.empty()) {
-                        task = std::move(other_data.local_queue.front());
-                        other_data.local_queue.pop();
-                        --other_data.work_count;
-                        --global_work_count_;
-                        break;
-                    }
-                }
+            if (job) {
+                run_job(job);
+                continue;
             }
             
-            if (task) {
-                try {
-                    task();
-                } catch (const std::exception& e) {
-                    std::cerr << "Work stealing task exception: " << e.what() << std::endl;
-                }
-            } else {
-                // No work found, wait for notification
-                std::unique_lock lock(global_mutex_);
-                work_available_.wait_for(lock, stoken, std::chrono::milliseconds(10), [this]() {
-                    return global_work_count_.load() > 0;
-                });
+            // Park: announce, recheck, then sleep until notified
+            uint32_t key = idle_.prepare_wait();
+            if ((job = find_job(worker_id)) != nullptr) {
+                idle_.cancel_wait();
+                run_job(job);
+                continue;
+            }
+            if (stoken.stop_requested()) {
+                idle_.cancel_wait();
+                break;
             }
+            idle_.commit_wait(key);
         }
+        
+        current_pool_ = nullptr;
     }
 };
 
+// Fork/join divide-and-conquer on WorkStealingThreadPool
+namespace fork_join {
+
+constexpr ptrdiff_t SEQUENTIAL_CUTOFF = 2048;
+
+// Quicksort (Hoare partition, median-of-three pivot): the left half is
+// spawned, the right half runs on the current worker
+template<typename T>
+void parallel_quicksort(WorkStealingThreadPool& pool, T* first, T* last) {
+    while (last - first > SEQUENTIAL_CUTOFF) {
+        T* mid = first + (last - first) / 2;
+        T a = *first, b = *mid, c = *(last - 1);
+        T pivot = std::max(std::min(a, b), std::min(std::max(a, b), c));
+        
+        T* i = first - 1;
+        T* j = last;
+        while (true) {
+            do { ++i; } while (*i < pivot);
+            do { --j; } while (pivot < *j);
+            if (i >= j) break;
+            std::iter_swap(i, j);
+        }
+        T* split = j + 1;
+        
+        WorkStealingThreadPool::TaskGroup group;
+        pool.spawn(group, [&pool, first, split]() {
+            parallel_quicksort(pool, first, split);
+        });
+        parallel_quicksort(pool, split, last);
+        pool.sync(group);
+        return;
+    }
+    std::sort(first, last);
+}
+
+// Mergesort: sort both halves in parallel, then merge through a buffer
+template<typename T>
+void parallel_mergesort(WorkStealingThreadPool& pool, T* first, T* last, T* buffer) {
+    const ptrdiff_t n = last - first;
+    if (n <= SEQUENTIAL_CUTOFF) {
+        std::sort(first, last);
+        return;
+    }
+    
+    T* mid = first + n / 2;
+    WorkStealingThreadPool::TaskGroup group;
+    pool.spawn(group, [&pool, first, mid, buffer]() {
+        parallel_mergesort(pool, first, mid, buffer);
+    });
+    parallel_mergesort(pool, mid, last, buffer + (mid - first));
+    pool.sync(group);
+    
+    std::merge(first, mid, mid, last, buffer);
+    std::copy(buffer, buffer + n, first);
+}
+
+} // namespace fork_join
+
 // 4. Demonstration functions
 void demonstrate_basic_thread_pool() {
     std::cout << "\n=== 1. Basic Modern Thread Pool ===" << std::endl;
@@ -403,7 +1578,7 @@ void demonstrate_basic_thread_pool() {
     ModernThreadPool pool(4);
     
     // Submit various tasks
-    std::vector<std::future<int>> results;
+    std::vector<TaskFuture<int>> results;
     
     for (int i = 0; i < 10; ++i) {
         results.push_back(pool.submit([i]() {
@@ -467,7 +1642,7 @@ void demonstrate_work_stealing_pool() {
     WorkStealingThreadPool pool(4);
     
     // Submit many small tasks to see work stealing in action
-    std::vector<std::future<int>> results;
+    std::vector<TaskFuture<int>> results;
     
     for (int i = 0; i < 20; ++i) {
         results.push_back(pool.submit([i]() {
@@ -483,6 +1658,35 @@ void demonstrate_work_stealing_pool() {
     for (auto& future : results) {
         future.get();
     }
+    
+    // Fork/join: recursive sorts via spawn()/sync()
+    std::cout << "\nFork/join sorting (spawn/sync):" << std::endl;
+    constexpr size_t N = 2'000'000;
+    std::mt19937 gen(42);
+    std::vector<int> input(N);
+    for (auto& x : input) x = static_cast<int>(gen());
+    
+    auto time_sort = [&](const char* name, auto&& sort_fn) {
+        std::vector<int> data = input;
+        auto start = std::chrono::steady_clock::now();
+        sort_fn(data);
+        auto ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "  " << std::left << std::setw(20) << name << std::right
+                  << std::fixed << std::setprecision(1) << ms << " ms"
+                  << (std::is_sorted(data.begin(), data.end()) ? "  (sorted)" : "  (NOT SORTED)")
+                  << std::defaultfloat << std::endl;
+    };
+    
+    time_sort("std::sort", [](std::vector<int>& v) {
+        std::sort(v.begin(), v.end());
+    });
+    time_sort("parallel quicksort", [&pool](std::vector<int>& v) {
+        fork_join::parallel_quicksort(pool, v.data(), v.data() + v.size());
+    });
+    time_sort("parallel mergesort", [&pool](std::vector<int>& v) {
+        std::vector<int> buffer(v.size());
+        fork_join::parallel_mergesort(pool, v.data(), v.data() + v.size(), buffer.data());
+    });
 }
 
 void demonstrate_thread_pool_patterns() {
@@ -493,7 +1697,7 @@ void demonstrate_thread_pool_patterns() {
     // Pattern 1: Parallel map operation
     std::cout << "Pattern 1: Parallel Map" << std::endl;
     std::vector<int> data = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
-    std::vector<std::future<int>> mapped_results;
+    std::vector<TaskFuture<int>> mapped_results;
     
     for (int value : data) {
         mapped_results.push_back(pool.submit([value]() {
@@ -589,6 +1793,189 @@ void demonstrate_thread_pool_patterns() {
     consumer_future.get();
 }
 
+void demonstrate_work_stealing_mode() {
+    std::cout << "\n=== 5. ModernThreadPool Work-Stealing Mode ===" << std::endl;
+    
+    ModernThreadPool pool(4, ModernThreadPool::Mode::WorkStealing);
+    
+    // Recursive fan-out: children are pushed onto the submitting worker's own
+    // deque, and idle workers steal them from the other end
+    std::atomic<int> leaves{0};
+    std::function<void(int)> fan_out = [&](int depth) {
+        if (depth == 0) {
+            leaves.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        for (int i = 0; i < 4; ++i) {
+            pool.post(fan_out, depth - 1);
+        }
+    };
+    
+    pool.post(fan_out, 6);
+    pool.wait_for_completion();
+    
+    std::cout << "Leaves visited: " << leaves.load() << " (expected " << (1 << 12) << ")" << std::endl;
+    std::cout << "Completed: " << pool.completed_tasks()
+              << ", Pending: " << pool.pending_tasks() << std::endl;
+}
+
+// Fine-grained fan-out: ROOTS external submissions, each spawning CHILDREN
+// tiny tasks from inside a worker. Reports tasks/second per mode.
+double benchmark_pool_mode(size_t threads, ModernThreadPool::Mode mode) {
+    constexpr int ROOTS = 64;
+    constexpr int CHILDREN = 256;
+    
+    std::atomic<uint64_t> checksum{0};
+    auto tiny_work = [&checksum](int seed) {
+        uint64_t x = static_cast<uint64_t>(seed);
+        for (int i = 0; i < 32; ++i) {
+            x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+        }
+        if (x == 0) checksum.fetch_add(1, std::memory_order_relaxed);
+    };
+    
+    ModernThreadPool pool(threads, mode);
+    auto start = std::chrono::steady_clock::now();
+    
+    for (int r = 0; r < ROOTS; ++r) {
+        pool.post([&pool, &tiny_work, r]() {
+            for (int c = 0; c < CHILDREN; ++c) {
+                pool.post(tiny_work, r * CHILDREN + c);
+            }
+        });
+    }
+    pool.wait_for_completion();
+    
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return (ROOTS * (CHILDREN + 1)) / elapsed;
+}
+
+void benchmark_global_queue_vs_work_stealing() {
+    std::cout << "\n=== 6. Benchmark: Global Queue vs Work Stealing ===" << std::endl;
+    
+    struct Row { size_t threads; double global_rate; double stealing_rate; };
+    std::vector<Row> rows;
+    
+    for (size_t threads : {1, 2, 4, 8, 16, 32, 64}) {
+        double global_rate = benchmark_pool_mode(threads, ModernThreadPool::Mode::GlobalQueue);
+        double stealing_rate = benchmark_pool_mode(threads, ModernThreadPool::Mode::WorkStealing);
+        rows.push_back({threads, global_rate, stealing_rate});
+    }
+    
+    std::cout << "\nthreads | global queue (tasks/s) | work stealing (tasks/s) | speedup" << std::endl;
+    for (const auto& row : rows) {
+        std::cout << std::setw(7) << row.threads << " | "
+                  << std::setw(22) << static_cast<uint64_t>(row.global_rate) << " | "
+                  << std::setw(23) << static_cast<uint64_t>(row.stealing_rate) << " | "
+                  << std::fixed << std::setprecision(2) << row.stealing_rate / row.global_rate << "x"
+                  << std::defaultfloat << std::endl;
+    }
+}
+
+// Global allocation counter for the submission-path benchmark below
+namespace alloc_stats {
+    std::atomic<size_t> allocations{0};
+}
+
+void* operator new(std::size_t size) {
+    alloc_stats::allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+// GCC flags free() inside a replaced operator delete as mismatched
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+#pragma GCC diagnostic pop
+
+void benchmark_submission_allocations() {
+    std::cout << "\n=== 7. Benchmark: Allocations per Submitted Task ===" << std::endl;
+    
+    constexpr int TASKS = 200000;
+    constexpr int BATCH = 256;
+    auto work = [](int x) { return x * 2 + 1; };
+    
+    struct Result { const char* name; double allocs_per_task; double ns_per_task; };
+    std::vector<Result> results;
+    
+    auto measure = [&](const char* name, auto&& run_batch) {
+        run_batch(); // Warm up free lists
+        size_t before = alloc_stats::allocations.load();
+        auto start = std::chrono::steady_clock::now();
+        for (int done = 0; done < TASKS; done += BATCH) {
+            run_batch();
+        }
+        auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        size_t allocs = alloc_stats::allocations.load() - before;
+        results.push_back({name, static_cast<double>(allocs) / TASKS, elapsed / TASKS});
+    };
+    
+    // Before: the original submit() path (bind + shared packaged_task +
+    // std::function wrapper + std::future), through a mutex-guarded queue.
+    // Run inline on this thread, so only its allocation count is comparable.
+    {
+        std::queue<std::function<void()>> legacy_queue;
+        std::mutex legacy_mutex;
+        measure("legacy packaged_task", [&]() {
+            std::vector<std::future<int>> futures;
+            futures.reserve(BATCH);
+            for (int i = 0; i < BATCH; ++i) {
+                auto task = std::make_shared<std::packaged_task<int()>>(std::bind(work, i));
+                futures.push_back(task->get_future());
+                std::lock_guard lock(legacy_mutex);
+                legacy_queue.emplace([task]() { (*task)(); });
+            }
+            std::lock_guard lock(legacy_mutex);
+            while (!legacy_queue.empty()) {
+                legacy_queue.front()();
+                legacy_queue.pop();
+            }
+            for (auto& f : futures) f.get();
+        });
+    }
+    
+    // After: submit() and post() on a real pool
+    for (auto mode : {ModernThreadPool::Mode::GlobalQueue, ModernThreadPool::Mode::WorkStealing}) {
+        ModernThreadPool pool(1, mode);
+        bool stealing = mode == ModernThreadPool::Mode::WorkStealing;
+        
+        std::vector<TaskFuture<int>> futures;
+        futures.reserve(BATCH);
+        measure(stealing ? "submit() work-stealing" : "submit() global queue", [&]() {
+            for (int i = 0; i < BATCH; ++i) {
+                futures.push_back(pool.submit(work, i));
+            }
+            for (auto& f : futures) f.get();
+            futures.clear();
+        });
+        
+        std::atomic<int> sink{0};
+        measure(stealing ? "post() work-stealing" : "post() global queue", [&]() {
+            for (int i = 0; i < BATCH; ++i) {
+                pool.post([&sink, i]() { sink.fetch_add(i, std::memory_order_relaxed); });
+            }
+            pool.wait_for_completion();
+        });
+    }
+    
+    std::cout << "\npath                   | allocations/task | ns/task" << std::endl;
+    for (const auto& r : results) {
+        std::cout << std::left << std::setw(22) << r.name << std::right << " | "
+                  << std::setw(16) << std::fixed << std::setprecision(3) << r.allocs_per_task << " | "
+                  << std::setw(7) << std::setprecision(1) << r.ns_per_task
+                  << std::defaultfloat << std::endl;
+    }
+}
+
 int main() {
     std::cout << "=== Modern C++ Thread Pool Implementations ===" << std::endl;
     
@@ -597,6 +1984,9 @@ int main() {
         demonstrate_priority_thread_pool();
         demonstrate_work_stealing_pool();
         demonstrate_thread_pool_patterns();
+        demonstrate_work_stealing_mode();
+        benchmark_global_queue_vs_work_stealing();
+        benchmark_submission_allocations();
         
     } catch (const std::exception& e) {
         std::cerr << "Exception: " << e.what() << std::endl;
@@ -615,6 +2005,7 @@ int main() {
     std::cout << "• Basic Thread Pool: Simple task submission and execution" << std::endl;
     std::cout << "• Priority Pool: Task prioritization and ordered execution" << std::endl;
     std::cout << "• Work Stealing: Dynamic load balancing between threads" << std::endl;
+    std::cout << "• Chase-Lev Deques: Lock-free per-worker queues with eventcount parking" << std::endl;
     std::cout << "• Parallel Map: Data parallelism with result collection" << std::endl;
     std::cout << "• Parallel Reduction: Divide-and-conquer aggregation" << std::endl;
     std::cout << "• Producer-Consumer: Coordinated batch processing" << std::endl;
@@ -657,11 +2048,26 @@ Thread Pool Patterns:
    - Time-based secondary ordering
    - Resource-aware task distribution
 
+1b. ModernThreadPool::Mode::WorkStealing:
+   - One lock-free Chase-Lev deque per worker (owner LIFO, thieves FIFO)
+   - Tasks submitted from a worker go to its own deque, no shared lock
+   - External submissions go through a small injector queue
+   - Idle workers steal from random victims, then park on an eventcount
+   - Producers only issue a wake-up when some worker is actually parked
+
+1c. Allocation-free submission:
+   - InlineTask: move-only callable with 64 bytes of inline storage
+   - Job nodes and TaskFuture shared states come from per-thread free
+     lists; blocks freed on another thread are returned to their owner
+   - post(): fire-and-forget, skips the future entirely
+
 3. Work-Stealing Thread Pool:
-   - Per-thread local queues
-   - Work stealing from other threads when idle
-   - Load balancing across workers
-   - Reduced contention on shared data
+   - Per-thread lock-free Chase-Lev deques (owner LIFO, thieves FIFO)
+   - Locality-aware victims: same L3, then same NUMA node, then anyone
+     (topology read from /sys/devices/system/cpu, workers pinned)
+   - Spin with exponential backoff before parking on an eventcount
+   - spawn()/sync() fork/join; syncing workers keep executing tasks
+   - Parallel quicksort and mergesort as divide-and-conquer examples
 
 Benefits:
 - Thread reuse reduces creation overhead
@@ -0,0 +1,366 @@
+#pragma once
+/*------------------------------------------------------------
+        Pool of persistent client connections to one server
+-------------------------------------------------------------*/
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+#include <linux/futex.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#include "MessageCodec.h"
+
+/**
+ * @brief Keeps up to maxSize open TCP connections to one server and lends
+ * them out, so a request does not pay for connect() (and the server for
+ * accept() and TIME_WAIT) every time.
+ *
+ * Idle connections sit on a lock-free LIFO stack: checkout() and checkin()
+ * are one compare-and-swap each when a connection is available. The stack
+ * links slot indices (not pointers) and the head carries a 32-bit version
+ * tag next to the index, so a slot that is popped and pushed back between
+ * another thread's load and CAS cannot be mistaken for an unchanged head
+ * (the ABA problem). LIFO order keeps the recently used, warm connections
+ * on top and lets the stale ones sink to the bottom, where evictIdle()
+ * finds them.
+ *
+ *   - grows on demand: an empty stack opens a new connection while fewer
+ *     than maxSize exist; at maxSize, checkout() sleeps on a futex until a
+ *     connection is returned
+ *   - validates lazily: a connection idle for longer than validateAfter is
+ *     checked before it is handed out (has the server closed it?)
+ *   - shrinks: connections idle for longer than idleTimeout are closed,
+ *     down to minSize, by a sweep that some checkout() runs now and then
+ */
+class ConnectionPool
+{
+public:
+    struct Options
+    {
+        uint32_t minSize = 1;
+        uint32_t maxSize = 16;
+        std::chrono::milliseconds idleTimeout{30000};
+        std::chrono::milliseconds validateAfter{1000};
+    };
+
+    struct Stats
+    {
+        uint64_t opened;
+        uint64_t evicted;       //idle timeout
+        uint64_t failedChecks;  //found closed or dirty when validated
+        uint64_t waits;         //checkouts that had to wait for a checkin
+    };
+
+    /**
+     * @brief A checked-out connection. Returned to the pool when destroyed;
+     * call markBroken() first if it must be closed instead (socket error,
+     * timeout, half-read reply).
+     */
+    class Lease
+    {
+    public:
+        Lease() = default;
+        Lease(Lease&& other) noexcept
+            : pool(std::exchange(other.pool, nullptr)), index(other.index), broken(other.broken) {}
+        Lease& operator=(Lease&& other) noexcept
+        {
+            if(this != &other)
+            {
+                release();
+                pool = std::exchange(other.pool, nullptr);
+                index = other.index;
+                broken = other.broken;
+            }
+            return *this;
+        }
+        ~Lease() { release(); }
+
+        explicit operator bool() const { return pool != nullptr; }
+        int sd() const { return pool->slots[index].sd; }
+        MessageCodec& codec() { return *pool->slots[index].codec; }
+        void markBroken() { broken = true; }
+
+        void release()
+        {
+            if(pool)
+                std::exchange(pool, nullptr)->checkin(index, broken);
+        }
+
+    private:
+        friend class ConnectionPool;
+        Lease(ConnectionPool* pool, uint32_t index) : pool(pool), index(index) {}
+
+        ConnectionPool* pool = nullptr;
+        uint32_t index = 0;
+        bool broken = false;
+    };
+
+    ConnectionPool(const sockaddr_in& server, Options options)
+        : server(server), options(options), slots(new Slot[options.maxSize])
+    {
+        for(uint32_t i = options.maxSize; i-- > 0;)
+            push(freeHead, i);
+        //open minSize connections up front so the first callers do not pay for them
+        std::vector<Lease> warm;
+        for(uint32_t i = 0; i < options.minSize; i++)
+        {
+            if(std::optional<Lease> lease = grow())
+                warm.push_back(std::move(*lease));
+        }
+        lastSweep.store(nowNs(), std::memory_order_relaxed);
+    }
+
+    //every lease must have been returned
+    ~ConnectionPool()
+    {
+        for(uint32_t i = pop(idleHead); i != EMPTY; i = pop(idleHead))
+            close(slots[i].sd);
+    }
+
+    ConnectionPool(const ConnectionPool&) = delete;
+    ConnectionPool& operator=(const ConnectionPool&) = delete;
+
+    /**
+     * @brief Lends out a connection, opening one if none is idle and the pool
+     * is below maxSize, otherwise waiting up to `timeout` for a checkin.
+     * Returns an empty Lease on timeout or when connect() fails.
+     */
+    Lease checkout(std::chrono::milliseconds timeout = std::chrono::milliseconds(-1))
+    {
+        int64_t now = nowNs();
+        int64_t deadline = timeout.count() < 0 ? INT64_MAX : now + timeout.count() * 1000000;
+        maybeSweep(now);
+        while(true)
+        {
+            uint32_t seen = returns.load();
+            uint32_t index = pop(idleHead);
+            if(index != EMPTY)
+            {
+                Slot& slot = slots[index];
+                int64_t idle = nowNs() - slot.idleSince;
+                if(idle > toNs(options.idleTimeout) && openCount.load() > options.minSize)
+                {
+                    evicted.fetch_add(1, std::memory_order_relaxed);
+                    discard(index);
+                    continue;
+                }
+                if(idle > toNs(options.validateAfter) && !stillUsable(slot))
+                {
+                    failedChecks.fetch_add(1, std::memory_order_relaxed);
+                    discard(index);
+                    continue;
+                }
+                return Lease(this, index);
+            }
+            if(std::optional<Lease> lease = grow())
+                return std::move(*lease); //empty if connect() failed
+            //at maxSize: sleep until some connection comes back (or is closed)
+            now = nowNs();
+            if(now >= deadline)
+                return Lease();
+            waits.fetch_add(1, std::memory_order_relaxed);
+            waitForReturn(seen, deadline == INT64_MAX ? -1 : deadline - now);
+        }
+    }
+
+    /**
+     * @brief Closes connections that have been idle for longer than
+     * idleTimeout, keeping at least minSize open. checkout() calls this
+     * itself every idleTimeout / 2; it is public for owners that want the
+     * pool to shrink while nobody is using it.
+     */
+    void evictIdle()
+    {
+        //detach the whole idle stack; meanwhile checkouts just see it empty
+        uint64_t head = idleHead.load(std::memory_order_acquire);
+        while(!idleHead.compare_exchange_weak(head, nextTag(head) | EMPTY, std::memory_order_acquire))
+        {
+        }
+        std::vector<uint32_t> idle; //most recently used first
+        for(uint32_t i = static_cast<uint32_t>(head); i != EMPTY; i = slots[i].next.load(std::memory_order_relaxed))
+            idle.push_back(i);
+
+        int64_t now = nowNs();
+        //oldest first; push the survivors back in the same order so the LIFO order is kept
+        for(size_t k = idle.size(); k-- > 0;)
+        {
+            uint32_t i = idle[k];
+            if(now - slots[i].idleSince > toNs(options.idleTimeout) && openCount.load() > options.minSize)
+            {
+                evicted.fetch_add(1, std::memory_order_relaxed);
+                discard(i);
+            }
+            else
+            {
+                push(idleHead, i);
+                wakeWaiters();
+            }
+        }
+    }
+
+    uint32_t size() const { return openCount.load(std::memory_order_relaxed); }
+
+    Stats stats() const
+    {
+        return {opened.load(std::memory_order_relaxed), evicted.load(std::memory_order_relaxed),
+                failedChecks.load(std::memory_order_relaxed), waits.load(std::memory_order_relaxed)};
+    }
+
+private:
+    static constexpr uint32_t EMPTY = UINT32_MAX;
+
+    struct Slot
+    {
+        int sd = -1;
+        std::optional<MessageCodec> codec;  //recreated for every new socket
+        int64_t idleSince = 0;
+        std::atomic<uint32_t> next{EMPTY};  //stack link; read racily by pop(), hence atomic
+    };
+
+    sockaddr_in server;
+    Options options;
+    std::unique_ptr<Slot[]> slots;
+    //stack heads: (version tag << 32) | slot index
+    std::atomic<uint64_t> idleHead{EMPTY};  //open, idle connections
+    std::atomic<uint64_t> freeHead{EMPTY};  //slots without a socket
+    std::atomic<uint32_t> openCount{0};     //idle + leased
+    std::atomic<uint32_t> returns{0};       //futex word: bumped whenever a connection comes back
+    std::atomic<uint32_t> waiters{0};
+    std::atomic<int64_t> lastSweep{0};
+    std::atomic<uint64_t> opened{0}, evicted{0}, failedChecks{0}, waits{0};
+
+    static int64_t nowNs()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    static int64_t toNs(std::chrono::milliseconds ms) { return ms.count() * 1000000; }
+
+    static uint64_t nextTag(uint64_t head) { return ((head >> 32) + 1) << 32; }
+
+    void push(std::atomic<uint64_t>& head, uint32_t index)
+    {
+        uint64_t old = head.load(std::memory_order_relaxed);
+        do
+        {
+            slots[index].next.store(static_cast<uint32_t>(old), std::memory_order_relaxed);
+        } while(!head.compare_exchange_weak(old, nextTag(old) | index, std::memory_order_release,
+                                            std::memory_order_relaxed));
+    }
+
+    uint32_t pop(std::atomic<uint64_t>& head)
+    {
+        uint64_t old = head.load(std::memory_order_acquire);
+        while(static_cast<uint32_t>(old) != EMPTY)
+        {
+            //may read the link of a slot that was just popped by someone else:
+            //harmless, the tag makes the CAS below fail
+            uint32_t next = slots[static_cast<uint32_t>(old)].next.load(std::memory_order_relaxed);
+            if(head.compare_exchange_weak(old, nextTag(old) | next, std::memory_order_acquire,
+                                          std::memory_order_acquire))
+                return static_cast<uint32_t>(old);
+        }
+        return EMPTY;
+    }
+
+    //reserves a place below maxSize and connects a free slot; nullopt when at maxSize
+    std::optional<Lease> grow()
+    {
+        uint32_t count = openCount.load();
+        do
+        {
+            if(count >= options.maxSize)
+                return std::nullopt;
+        } while(!openCount.compare_exchange_weak(count, count + 1));
+        //slots are freed before openCount drops, so a free slot exists
+        uint32_t index = pop(freeHead);
+        Slot& slot = slots[index];
+        slot.sd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if(slot.sd < 0 || connect(slot.sd, (const sockaddr*)&server, sizeof(server)) < 0)
+        {
+            if(slot.sd >= 0)
+                close(slot.sd);
+            push(freeHead, index);
+            openCount.fetch_sub(1);
+            wakeWaiters();
+            return std::optional<Lease>(Lease());
+        }
+        int one = 1;
+        setsockopt(slot.sd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        slot.codec.emplace();
+        opened.fetch_add(1, std::memory_order_relaxed);
+        return std::optional<Lease>(Lease(this, index));
+    }
+
+    void checkin(uint32_t index, bool broken)
+    {
+        Slot& slot = slots[index];
+        if(broken)
+        {
+            discard(index);
+            return;
+        }
+        slot.idleSince = nowNs();
+        push(idleHead, index);
+        wakeWaiters();
+    }
+
+    void discard(uint32_t index)
+    {
+        Slot& slot = slots[index];
+        close(slot.sd);
+        slot.sd = -1;
+        slot.codec.reset();
+        push(freeHead, index);
+        openCount.fetch_sub(1);
+        wakeWaiters(); //a waiter may now open a new connection
+    }
+
+    /*
+        An idle connection should have nothing to read. Readable means the server
+        closed it (recv() would return 0), reset it, or sent bytes nobody asked
+        for; in every case it cannot be reused.
+    */
+    static bool stillUsable(Slot& slot)
+    {
+        pollfd pfd{slot.sd, POLLIN, 0};
+        return poll(&pfd, 1, 0) == 0;
+    }
+
+    void wakeWaiters()
+    {
+        returns.fetch_add(1);
+        if(waiters.load() > 0)
+            syscall(SYS_futex, reinterpret_cast<uint32_t*>(&returns), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+    }
+
+    //timeoutNs < 0: no timeout
+    void waitForReturn(uint32_t seen, int64_t timeoutNs)
+    {
+        waiters.fetch_add(1);
+        timespec ts{static_cast<time_t>(timeoutNs / 1000000000), static_cast<long>(timeoutNs % 1000000000)};
+        //sleeps only if `returns` still equals `seen`: a checkin in between cannot be missed
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&returns), FUTEX_WAIT_PRIVATE, seen,
+                timeoutNs < 0 ? nullptr : &ts, nullptr, 0);
+        waiters.fetch_sub(1);
+    }
+
+    void maybeSweep(int64_t now)
+    {
+        int64_t last = lastSweep.load(std::memory_order_relaxed);
+        if(now - last > toNs(options.idleTimeout) / 2 &&
+           lastSweep.compare_exchange_strong(last, now, std::memory_order_relaxed))
+            evictIdle();
+    }
+};
@@ -0,0 +1,526 @@
+#pragma once
+/*------------------------------------------------------------
+        Zero-copy file transfer on top of MessageCodec frames
+-------------------------------------------------------------*/
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <fcntl.h>
+#include <linux/openat2.h>
+#include <sys/mman.h>
+#include <sys/sendfile.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include "MessageCodec.h"
+
+/*
+    A FILE_REQUEST frame asks for a byte range of a file below the server's
+    file root:
+
+        0          8          16
+        +----------+----------+----------------+
+        |  offset  |  length  |  path ...      |      length 0 = to the end
+        +----------+----------+----------------+
+
+    The answer is either an ERROR frame or a FILE_DATA frame
+
+        +-------------+----------+----------+
+        |  file size  |  offset  |  length  |         file size ~0 = unknown
+        +-------------+----------+----------+
+
+    followed by exactly `length` raw bytes, NOT framed: the server streams
+    them from the page cache with sendfile(2), or with splice(2) through a
+    pipe when the source is not a regular file, so they never pass through
+    a user-space buffer. A range past the end is clamped, which makes
+    resuming a download just a request at offset = bytes already on disk.
+*/
+
+constexpr uint64_t UNKNOWN_FILE_SIZE = ~uint64_t(0);
+constexpr size_t FILE_DATA_HEADER_SIZE = 24;
+
+inline void putU64(uint8_t* out, uint64_t value)
+{
+    for(int i = 7; i >= 0; i--, value >>= 8)
+        out[i] = static_cast<uint8_t>(value);
+}
+
+inline uint64_t getU64(const uint8_t* in)
+{
+    uint64_t value = 0;
+    for(int i = 0; i < 8; i++)
+        value = (value << 8) | in[i];
+    return value;
+}
+
+/**
+ * @brief Streams one byte range of a file to a non-blocking socket.
+ *
+ * pump() moves as much as the socket takes and reports what it is waiting
+ * for, so an event loop can serve many transfers side by side. COPY is the
+ * classic pread()-into-a-buffer-then-send() loop, kept as the baseline.
+ */
+class FileSender
+{
+public:
+    enum class Method { AUTO, SPLICE, COPY };   //AUTO: sendfile for regular files, splice otherwise
+    enum class Progress { DONE, WAIT_SOCKET, WAIT_SOURCE, FAILED };
+
+    FileSender() = default;
+    FileSender(const FileSender&) = delete;
+    FileSender& operator=(const FileSender&) = delete;
+
+    ~FileSender()
+    {
+        if(fd >= 0)
+            close(fd);
+        if(pipeFds[0] >= 0)
+        {
+            close(pipeFds[0]);
+            close(pipeFds[1]);
+        }
+    }
+
+    /**
+     * @brief Opens `path` relative to the directory `rootFd` and selects the
+     * range. Returns an empty string on success, otherwise the reason to put
+     * in an ERROR frame. Paths that leave the root (.., absolute paths,
+     * symlinks pointing outside) are refused by the kernel (RESOLVE_BENEATH).
+     */
+    std::string open(int rootFd, std::string_view path, uint64_t offset, uint64_t length, Method method = Method::AUTO)
+    {
+        open_how how{};
+        how.flags = O_RDONLY | O_NONBLOCK | O_CLOEXEC;
+        how.resolve = RESOLVE_BENEATH | RESOLVE_NO_MAGICLINKS;
+        std::string name(path);
+        fd = static_cast<int>(syscall(SYS_openat2, rootFd, name.c_str(), &how, sizeof(how)));
+        if(fd < 0)
+            return "cannot open " + name + ": " + strerror(errno);
+
+        struct stat st;
+        fstat(fd, &st);
+        regular = S_ISREG(st.st_mode);
+        if(S_ISDIR(st.st_mode))
+            return name + " is a directory";
+        if(regular)
+        {
+            size = static_cast<uint64_t>(st.st_size);
+            if(offset > size)
+                return "range not satisfiable";
+            remaining = (length == 0 || length > size - offset) ? size - offset : length;
+        }
+        else
+        {
+            //devices, pipes, sockets: no size to clamp against, so the range must be explicit
+            size = UNKNOWN_FILE_SIZE;
+            if(length == 0)
+                return "a length is required for " + name;
+            seekable = lseek(fd, 0, SEEK_CUR) >= 0;
+            if(offset > 0 && !seekable)
+                return "cannot seek in " + name;
+            remaining = length;
+        }
+        position = static_cast<off_t>(offset);
+        start = offset;
+        rangeLength = remaining;
+
+        useSplice = method == Method::SPLICE || (method == Method::AUTO && !regular);
+        useCopy = method == Method::COPY;
+        if(useSplice && pipe2(pipeFds, O_NONBLOCK | O_CLOEXEC) < 0)
+            return std::string("cannot create pipe: ") + strerror(errno);
+        return "";
+    }
+
+    //the FILE_DATA header announcing this transfer
+    std::array<uint8_t, FILE_DATA_HEADER_SIZE> header() const
+    {
+        std::array<uint8_t, FILE_DATA_HEADER_SIZE> out;
+        putU64(out.data(), size);
+        putU64(out.data() + 8, start);
+        putU64(out.data() + 16, rangeLength);
+        return out;
+    }
+
+    int sourceFd() const { return fd; }
+    bool pollableSource() const { return !regular; }  //regular files are always "ready"
+    uint64_t bytesLeft() const { return remaining + inPipe + copyLength - copyOffset; }
+
+    /**
+     * @brief Sends until the range is done, the socket is full, the source has
+     * no data, or `quantum` bytes went out (so one big transfer cannot starve
+     * the other connections of the loop; the socket is still writable then,
+     * so the loop comes straight back).
+     */
+    Progress pump(int sd, size_t quantum = 8 << 20)
+    {
+        if(useCopy)
+            return pumpCopy(sd, quantum);
+        if(useSplice)
+            return pumpSplice(sd, quantum);
+        return pumpSendfile(sd, quantum);
+    }
+
+private:
+    int fd = -1;
+    bool regular = false;
+    bool seekable = true;
+    bool useSplice = false;
+    bool useCopy = false;
+    uint64_t size = 0;
+    uint64_t start = 0;
+    uint64_t rangeLength = 0;
+    off_t position = 0;         //next byte to read from the source
+    uint64_t remaining = 0;     //bytes not yet read from the source
+    int pipeFds[2] = {-1, -1};  //splice: source -> pipe -> socket
+    size_t inPipe = 0;
+    std::vector<uint8_t> buffer;    //copy: bytes read but not yet sent
+    size_t copyOffset = 0;
+    size_t copyLength = 0;
+
+    Progress pumpSendfile(int sd, size_t quantum)
+    {
+        while(remaining > 0)
+        {
+            if(quantum == 0)
+                return Progress::WAIT_SOCKET;
+            size_t chunk = std::min<uint64_t>(remaining, quantum);
+            ssize_t n = sendfile(sd, fd, &position, chunk);
+            if(n > 0)
+            {
+                remaining -= n;
+                quantum -= n;
+            }
+            else if(n < 0 && errno == EINTR)
+                continue;
+            else if(n < 0 && errno == EAGAIN)
+                return Progress::WAIT_SOCKET;
+            else
+                return Progress::FAILED; //socket error, or the file shrank under us
+        }
+        return Progress::DONE;
+    }
+
+    Progress pumpSplice(int sd, size_t quantum)
+    {
+        const size_t PIPE_CAPACITY = 64 * 1024; //the default pipe size
+        while(remaining > 0 || inPipe > 0)
+        {
+            bool sourceEmpty = false;
+            if(remaining > 0 && inPipe < PIPE_CAPACITY)
+            {
+                size_t chunk = std::min<uint64_t>(remaining, PIPE_CAPACITY - inPipe);
+                loff_t offset = position;
+                ssize_t n = splice(fd, seekable ? &offset : nullptr, pipeFds[1], nullptr, chunk,
+                                   SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+                if(n > 0)
+                {
+                    position += n;
+                    remaining -= n;
+                    inPipe += n;
+                }
+                else if(n == 0 && !seekable && position == static_cast<off_t>(start))
+                    sourceEmpty = true;      //a FIFO whose writer has not opened it yet
+                else if(n == 0)
+                    return Progress::FAILED; //source ended before the requested length
+                else if(errno == EAGAIN)
+                    sourceEmpty = true;      //no data yet (or the pipe is full)
+                else if(errno != EINTR)
+                    return Progress::FAILED;
+            }
+            if(inPipe == 0)
+            {
+                if(sourceEmpty)
+                    return Progress::WAIT_SOURCE;
+                continue;
+            }
+            if(quantum == 0)
+                return Progress::WAIT_SOCKET;
+            ssize_t n = splice(pipeFds[0], nullptr, sd, nullptr, std::min(inPipe, quantum),
+                               SPLICE_F_MOVE | SPLICE_F_NONBLOCK | (remaining > 0 ? SPLICE_F_MORE : 0));
+            if(n > 0)
+            {
+                inPipe -= n;
+                quantum -= std::min<size_t>(quantum, n);
+            }
+            else if(n < 0 && errno == EAGAIN)
+                return Progress::WAIT_SOCKET;
+            else if(!(n < 0 && errno == EINTR))
+                return Progress::FAILED;
+        }
+        return Progress::DONE;
+    }
+
+    Progress pumpCopy(int sd, size_t quantum)
+    {
+        if(buffer.empty())
+            buffer.resize(64 * 1024);
+        while(remaining > 0 || copyOffset < copyLength)
+        {
+            if(copyOffset == copyLength)
+            {
+                ssize_t n = pread(fd, buffer.data(), std::min<uint64_t>(remaining, buffer.size()), position);
+                if(n < 0 && errno == EINTR)
+                    continue;
+                if(n <= 0)
+                    return Progress::FAILED;
+                position += n;
+                remaining -= n;
+                copyOffset = 0;
+                copyLength = n;
+            }
+            if(quantum == 0)
+                return Progress::WAIT_SOCKET;
+            ssize_t n = send(sd, buffer.data() + copyOffset, copyLength - copyOffset, MSG_NOSIGNAL);
+            if(n > 0)
+            {
+                copyOffset += n;
+                quantum -= std::min<size_t>(quantum, n);
+            }
+            else if(n < 0 && errno == EAGAIN)
+                return Progress::WAIT_SOCKET;
+            else if(!(n < 0 && errno == EINTR))
+                return Progress::FAILED;
+        }
+        return Progress::DONE;
+    }
+};
+
+struct FileReceipt
+{
+    uint64_t fileSize = 0;
+    uint64_t offset = 0;
+    uint64_t length = 0;
+    uint64_t received = 0;
+};
+
+//sends a FILE_REQUEST and reads the FILE_DATA header that answers it
+inline bool requestFileRange(int sd, MessageCodec& codec, uint32_t sequence, std::string_view remotePath,
+                             uint64_t offset, uint64_t length, FileReceipt& receipt, std::string& error)
+{
+    std::vector<uint8_t> request(16 + remotePath.size());
+    putU64(request.data(), offset);
+    putU64(request.data() + 8, length);
+    std::memcpy(request.data() + 16, remotePath.data(), remotePath.size());
+    codec.enqueue(MessageType::FILE_REQUEST, sequence, request);
+    if(!codec.flush(sd))
+    {
+        error = "send failed";
+        return false;
+    }
+
+    std::optional<Frame> frame = codec.receiveFrame(sd);
+    if(!frame)
+    {
+        error = "connection closed";
+        return false;
+    }
+    if(frame->type == MessageType::ERROR)
+    {
+        error.assign(reinterpret_cast<const char*>(frame->payload.data()), frame->payload.size());
+        return false;
+    }
+    if(frame->type != MessageType::FILE_DATA || frame->payload.size() != FILE_DATA_HEADER_SIZE)
+    {
+        error = "unexpected reply";
+        return false;
+    }
+    receipt.fileSize = getU64(frame->payload.data());
+    receipt.offset = getU64(frame->payload.data() + 8);
+    receipt.length = getU64(frame->payload.data() + 16);
+    receipt.received = 0;
+    return true;
+}
+
+/*
+    Reserves the announced range of `fd` with fallocate(FALLOC_FL_KEEP_SIZE),
+    maps it and recv()s straight into the mapping. The caller has already
+    made the file long enough to map the range, plus PROGRESS_TRAILER_SIZE
+    bytes after it when `trailer` is set: those then hold offset + received,
+    rewritten after every recv().
+*/
+constexpr size_t PROGRESS_TRAILER_SIZE = 8;
+
+inline bool receiveFileRange(int sd, MessageCodec& codec, int fd, FileReceipt& receipt, bool trailer,
+                             std::string& error)
+{
+    uint64_t end = receipt.offset + receipt.length;
+    //reserve the blocks up front: no ENOSPC halfway, and the file is laid out in one go
+    if(fallocate(fd, FALLOC_FL_KEEP_SIZE, receipt.offset, receipt.length) < 0 && errno == ENOSPC)
+    {
+        error = std::string("cannot allocate destination: ") + strerror(errno);
+        return false;
+    }
+    //mmap offsets must be page aligned
+    uint64_t mapStart = receipt.offset & ~(static_cast<uint64_t>(sysconf(_SC_PAGESIZE)) - 1);
+    size_t mapLength = end - mapStart + (trailer ? PROGRESS_TRAILER_SIZE : 0);
+    void* area = mmap(nullptr, mapLength, PROT_READ | PROT_WRITE, MAP_SHARED, fd, mapStart);
+    if(area == MAP_FAILED)
+    {
+        error = std::string("cannot map destination: ") + strerror(errno);
+        return false;
+    }
+    madvise(area, mapLength, MADV_SEQUENTIAL);
+    uint8_t* out = static_cast<uint8_t*>(area) + (receipt.offset - mapStart);
+    uint8_t* progress = trailer ? out + receipt.length : nullptr;
+
+    //the first bytes may already sit in the codec's ring behind the header frame
+    receipt.received = codec.takeBuffered(out, receipt.length);
+    if(progress)
+        putU64(progress, receipt.offset + receipt.received);
+    while(receipt.received < receipt.length)
+    {
+        ssize_t n = recv(sd, out + receipt.received, receipt.length - receipt.received, 0);
+        if(n > 0)
+        {
+            receipt.received += n;
+            //the page cache outlives the process, so a killed client leaves this behind too
+            if(progress)
+                putU64(progress, receipt.offset + receipt.received);
+        }
+        else if(!(n < 0 && errno == EINTR))
+            break;
+    }
+    munmap(area, mapLength);
+    if(receipt.received < receipt.length)
+    {
+        error = "connection closed after " + std::to_string(receipt.received) + " of " +
+                std::to_string(receipt.length) + " bytes";
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Requests `remotePath` [offset, offset + length) over a blocking
+ * socket and writes it into `localPath` at the same offset.
+ *
+ * The destination range is preallocated with fallocate() and mapped, and
+ * recv() writes straight into the mapped page cache: one copy from the
+ * socket, none through a user-space buffer or write(). The file only grows
+ * as far as the mapping needs, and if the connection drops it is cut back
+ * to the bytes that did arrive. A killed process can leave it longer; use
+ * downloadFile() when the file size must be a safe resume offset. Returns
+ * false with `error` set on failure.
+ */
+inline bool fetchFile(int sd, MessageCodec& codec, uint32_t sequence, std::string_view remotePath,
+                      const std::string& localPath, uint64_t offset, uint64_t length,
+                      FileReceipt& receipt, std::string& error)
+{
+    if(!requestFileRange(sd, codec, sequence, remotePath, offset, length, receipt, error))
+        return false;
+    if(receipt.length == 0)
+        return true; //nothing left: the local copy is already complete
+
+    int fd = ::open(localPath.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if(fd < 0)
+    {
+        error = "cannot open " + localPath + ": " + strerror(errno);
+        return false;
+    }
+    struct stat st;
+    fstat(fd, &st);
+    uint64_t previousSize = static_cast<uint64_t>(st.st_size);
+    uint64_t end = receipt.offset + receipt.length;
+    //mapped pages past the end of the file would fault with SIGBUS
+    if(end > previousSize && ftruncate(fd, end) < 0)
+    {
+        error = std::string("cannot extend destination: ") + strerror(errno);
+        close(fd);
+        return false;
+    }
+    bool complete = receiveFileRange(sd, codec, fd, receipt, false, error);
+    //keep only what arrived so that the file size is the resume offset
+    if(!complete && end > previousSize)
+        ftruncate(fd, std::max(previousSize, receipt.offset + receipt.received));
+    close(fd);
+    return complete;
+}
+
+/**
+ * @brief Downloads all of `remotePath` into `localPath`, continuing where an
+ * earlier call stopped.
+ *
+ * The bytes are received into `localPath + ".part"` as in fetchFile(), and
+ * the file is renamed to `localPath` only after the last one arrives, so
+ * `localPath` never holds a torn copy. The .part file ends with an 8-byte
+ * count of the bytes received so far, and the next call resumes from that
+ * count rather than from the file size, which covers the preallocated range
+ * whether or not it was filled. An existing `localPath` is treated as a
+ * complete earlier download and only extended if the remote file grew.
+ */
+inline bool downloadFile(int sd, MessageCodec& codec, uint32_t sequence, std::string_view remotePath,
+                         const std::string& localPath, FileReceipt& receipt, std::string& error)
+{
+    const std::string partPath = localPath + ".part";
+    struct stat st;
+    uint64_t offset = 0;
+    bool resumingPart = false;
+    int fd = ::open(partPath.c_str(), O_RDWR | O_CLOEXEC);
+    if(fd >= 0)
+    {
+        uint8_t count[PROGRESS_TRAILER_SIZE];
+        fstat(fd, &st);
+        uint64_t size = static_cast<uint64_t>(st.st_size);
+        if(size >= PROGRESS_TRAILER_SIZE &&
+           pread(fd, count, sizeof(count), size - PROGRESS_TRAILER_SIZE) == static_cast<ssize_t>(sizeof(count)))
+            offset = std::min(getU64(count), size - PROGRESS_TRAILER_SIZE);
+        resumingPart = true;
+    }
+    else if(stat(localPath.c_str(), &st) == 0)
+        offset = static_cast<uint64_t>(st.st_size);
+
+    if(!requestFileRange(sd, codec, sequence, remotePath, offset, 0, receipt, error))
+    {
+        if(fd >= 0)
+            close(fd);
+        return false;
+    }
+    if(!resumingPart && receipt.length == 0)
+        return true; //nothing left: the local copy is already complete
+    if(!resumingPart)
+    {
+        //extending a finished copy: it stays out of sight until the new bytes are in
+        if(offset > 0 && rename(localPath.c_str(), partPath.c_str()) < 0)
+        {
+            error = "cannot move " + localPath + " aside: " + strerror(errno);
+            return false;
+        }
+        fd = ::open(partPath.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if(fd < 0)
+        {
+            error = "cannot open " + partPath + ": " + strerror(errno);
+            return false;
+        }
+    }
+
+    uint64_t end = receipt.offset + receipt.length;
+    bool complete = true;
+    if(receipt.length > 0)
+    {
+        //move the count to the new end before any byte lands where the old one was
+        uint8_t count[PROGRESS_TRAILER_SIZE];
+        putU64(count, receipt.offset);
+        if(ftruncate(fd, end + PROGRESS_TRAILER_SIZE) < 0 ||
+           pwrite(fd, count, sizeof(count), end) != static_cast<ssize_t>(sizeof(count)))
+        {
+            error = std::string("cannot extend destination: ") + strerror(errno);
+            close(fd);
+            return false;
+        }
+        complete = receiveFileRange(sd, codec, fd, receipt, true, error);
+    }
+    if(complete && (ftruncate(fd, end) < 0 || rename(partPath.c_str(), localPath.c_str()) < 0))
+    {
+        error = "cannot move " + partPath + " into place: " + strerror(errno);
+        complete = false;
+    }
+    close(fd);
+    return complete;
+}
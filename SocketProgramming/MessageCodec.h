@@ -0,0 +1,362 @@
+#pragma once
+/*------------------------------------------------------------
+        Length-prefixed framing shared by server and client
+-------------------------------------------------------------*/
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <arpa/inet.h>
+#include <limits.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+/*
+    Wire format: every message is a 12-byte header followed by `length`
+    payload bytes. Header fields are big-endian (network byte order).
+
+        0          4        6         8            12
+        +----------+--------+---------+------------+------------------+
+        |  length  |  type  |  flags  |  sequence  |  payload ...     |
+        +----------+--------+---------+------------+------------------+
+
+    No terminator and no fixed buffer size: a payload can hold any bytes
+    (including NUL) up to MAX_FRAME_PAYLOAD.
+*/
+
+enum class MessageType : uint16_t
+{
+    TEXT = 1,           //application data; the threaded server echoes it back
+    EXIT = 2,           //end of session, no payload
+    FILE_REQUEST = 3,   //offset | length | path, see FileTransfer.h
+    FILE_DATA = 4,      //file size | offset | length, then `length` raw bytes
+    ERROR = 5           //a request failed; the payload is the reason as text
+};
+
+constexpr size_t FRAME_HEADER_SIZE = 12;
+constexpr uint32_t MAX_FRAME_PAYLOAD = 64u << 20; //larger lengths are treated as corrupt input
+
+/**
+ * @brief A decoded message. The payload points into the codec's receive
+ * buffer (no copy) and stays valid until the next readFrom() call.
+ */
+struct Frame
+{
+    MessageType type;
+    uint16_t flags;
+    uint32_t sequence;
+    std::span<const uint8_t> payload;
+};
+
+inline void encodeFrameHeader(uint8_t* out, MessageType type, uint32_t sequence, uint32_t length, uint16_t flags = 0)
+{
+    uint32_t netLength = htonl(length);
+    uint16_t netType = htons(static_cast<uint16_t>(type));
+    uint16_t netFlags = htons(flags);
+    uint32_t netSequence = htonl(sequence);
+    std::memcpy(out, &netLength, 4);
+    std::memcpy(out + 4, &netType, 2);
+    std::memcpy(out + 6, &netFlags, 2);
+    std::memcpy(out + 8, &netSequence, 4);
+}
+
+/**
+ * @brief Receive buffer whose pages are mapped twice, back to back.
+ *
+ * Byte i and byte i + capacity are the same memory, so every unread range
+ * (up to the capacity) is contiguous even when it wraps around the end of
+ * the ring. recv() writes straight into the free space and frames are read
+ * in place; nothing is ever memmove'd to the front.
+ */
+class ReceiveRing
+{
+public:
+    explicit ReceiveRing(size_t minCapacity = 64 * 1024) { map(roundCapacity(minCapacity)); }
+
+    ~ReceiveRing() { unmap(); }
+
+    ReceiveRing(const ReceiveRing&) = delete;
+    ReceiveRing& operator=(const ReceiveRing&) = delete;
+
+    uint8_t* readPtr() const { return base + (head & (capacity - 1)); }
+    size_t readable() const { return tail - head; }
+    void consume(size_t n) { head += n; }
+
+    uint8_t* writePtr() const { return base + (tail & (capacity - 1)); }
+    size_t writable() const { return capacity - readable(); }
+    void produce(size_t n) { tail += n; }
+
+    size_t size() const { return capacity; }
+
+    /**
+     * @brief Grows the ring to hold at least `minCapacity` bytes, keeping the
+     * unread bytes. This is the only copy the ring ever makes, and only when
+     * a frame is larger than anything seen before on this connection.
+     */
+    void reserve(size_t minCapacity)
+    {
+        if(minCapacity <= capacity)
+            return;
+        ReceiveRing bigger(minCapacity);
+        std::memcpy(bigger.base, readPtr(), readable());
+        bigger.tail = readable();
+        std::swap(base, bigger.base);
+        std::swap(capacity, bigger.capacity);
+        head = 0;
+        tail = bigger.tail;
+    }
+
+private:
+    uint8_t* base = nullptr;
+    size_t capacity = 0;     //power of two, multiple of the page size
+    uint64_t head = 0;       //next byte to parse
+    uint64_t tail = 0;       //next byte recv() fills
+
+    static size_t roundCapacity(size_t n)
+    {
+        size_t capacity = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        while(capacity < n)
+            capacity *= 2;
+        return capacity;
+    }
+
+    void map(size_t bytes)
+    {
+        int fd = memfd_create("receive-ring", MFD_CLOEXEC);
+        if(fd < 0 || ftruncate(fd, bytes) < 0)
+        {
+            if(fd >= 0)
+                close(fd);
+            throw std::runtime_error("ReceiveRing: cannot create backing memory");
+        }
+        //reserve 2x address space, then map the same pages into both halves
+        void* area = mmap(nullptr, 2 * bytes, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        uint8_t* start = static_cast<uint8_t*>(area);
+        if(area == MAP_FAILED ||
+           mmap(start, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED ||
+           mmap(start + bytes, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED)
+        {
+            if(area != MAP_FAILED)
+                munmap(area, 2 * bytes);
+            close(fd);
+            throw std::runtime_error("ReceiveRing: cannot map ring");
+        }
+        close(fd); //the mappings keep the memory alive
+        base = start;
+        capacity = bytes;
+    }
+
+    void unmap()
+    {
+        if(base)
+            munmap(base, 2 * capacity);
+        base = nullptr;
+    }
+};
+
+/**
+ * @brief Frames outgoing messages and parses incoming ones for one socket.
+ *
+ * Sending: enqueue() records a header plus a pointer to the caller's
+ * payload; flush() hands all queued frames to the kernel in as few
+ * sendmsg() calls as possible (scatter/gather, up to IOV_MAX pieces each).
+ * Payloads are never copied, so they must stay alive until flush() has
+ * sent them.
+ *
+ * Receiving: readFrom() does one recv() into the ring's free space and
+ * nextFrame() returns complete frames whose payload spans point into the
+ * ring.
+ */
+class MessageCodec
+{
+public:
+    explicit MessageCodec(size_t ringCapacity = 64 * 1024) : ringCapacity(ringCapacity) {}
+
+    // ---------- sending ----------
+
+    void enqueue(MessageType type, uint32_t sequence, std::span<const uint8_t> payload = {}, uint16_t flags = 0)
+    {
+        std::array<uint8_t, FRAME_HEADER_SIZE>& header = headers.emplace_back();
+        encodeFrameHeader(header.data(), type, sequence, static_cast<uint32_t>(payload.size()), flags);
+        iov.push_back({header.data(), FRAME_HEADER_SIZE});
+        if(!payload.empty())
+            iov.push_back({const_cast<uint8_t*>(payload.data()), payload.size()});
+    }
+
+    void enqueue(MessageType type, uint32_t sequence, const std::string& text)
+    {
+        enqueue(type, sequence, {reinterpret_cast<const uint8_t*>(text.data()), text.size()});
+    }
+
+    bool hasPending() const { return iovIndex < iov.size(); }
+
+    /**
+     * @brief Sends queued frames. Returns false on a socket error. On a
+     * non-blocking socket it may return true with frames still pending
+     * (hasPending()); call again once the socket is writable.
+     *
+     * Every sendmsg() but the last carries MSG_MORE, and so does the last
+     * one when `moreComing` is set: on a TCP_NODELAY socket this keeps the
+     * kernel from pushing a partial segment that more data will follow.
+     */
+    bool flush(int sd, bool moreComing = false)
+    {
+        while(iovIndex < iov.size())
+        {
+            msghdr msg{};
+            msg.msg_iov = iov.data() + iovIndex;
+            msg.msg_iovlen = std::min<size_t>(iov.size() - iovIndex, IOV_MAX);
+            bool lastChunk = iovIndex + msg.msg_iovlen == iov.size();
+            ssize_t n = sendmsg(sd, &msg, MSG_NOSIGNAL | (lastChunk && !moreComing ? 0 : MSG_MORE));
+            if(n < 0)
+            {
+                if(errno == EINTR)
+                    continue;
+                return errno == EAGAIN || errno == EWOULDBLOCK;
+            }
+            sent += n;
+            //skip what the kernel took; a partially sent piece is trimmed in place
+            size_t left = static_cast<size_t>(n);
+            while(left > 0 && left >= iov[iovIndex].iov_len)
+                left -= iov[iovIndex++].iov_len;
+            if(left > 0)
+            {
+                iov[iovIndex].iov_base = static_cast<uint8_t*>(iov[iovIndex].iov_base) + left;
+                iov[iovIndex].iov_len -= left;
+            }
+        }
+        iov.clear();
+        headers.clear();
+        iovIndex = 0;
+        return true;
+    }
+
+    // ---------- receiving ----------
+
+    /**
+     * @brief One recv() into the receive ring. Returns the byte count, 0 at
+     * EOF, or -1 with errno set (EAGAIN on an idle non-blocking socket).
+     * Invalidates the payload spans of previously returned frames.
+     */
+    ssize_t readFrom(int sd)
+    {
+        if(!ring)
+            ring.emplace(ringCapacity);
+        //make room for the whole frame that is currently arriving
+        if(ring->readable() >= FRAME_HEADER_SIZE)
+        {
+            size_t frameSize = FRAME_HEADER_SIZE + peekLength();
+            if(frameSize <= FRAME_HEADER_SIZE + MAX_FRAME_PAYLOAD)
+                ring->reserve(frameSize);
+        }
+        if(ring->writable() == 0)
+        {
+            errno = ENOBUFS; //caller did not drain nextFrame()
+            return -1;
+        }
+        ssize_t n;
+        do
+        {
+            n = recv(sd, ring->writePtr(), ring->writable(), 0);
+        } while(n < 0 && errno == EINTR);
+        if(n > 0)
+        {
+            ring->produce(n);
+            received += n;
+        }
+        return n;
+    }
+
+    /**
+     * @brief Returns the next complete frame, or nullopt if more bytes are
+     * needed (or the stream is corrupt; see protocolError()).
+     */
+    std::optional<Frame> nextFrame()
+    {
+        if(!ring || ring->readable() < FRAME_HEADER_SIZE)
+            return std::nullopt;
+        uint32_t length = peekLength();
+        if(length > MAX_FRAME_PAYLOAD)
+        {
+            corrupt = true;
+            return std::nullopt;
+        }
+        if(ring->readable() < FRAME_HEADER_SIZE + length)
+            return std::nullopt;
+
+        const uint8_t* header = ring->readPtr();
+        uint16_t type, flags;
+        uint32_t sequence;
+        std::memcpy(&type, header + 4, 2);
+        std::memcpy(&flags, header + 6, 2);
+        std::memcpy(&sequence, header + 8, 4);
+        Frame frame{static_cast<MessageType>(ntohs(type)), ntohs(flags), ntohl(sequence),
+                    {header + FRAME_HEADER_SIZE, length}};
+        ring->consume(FRAME_HEADER_SIZE + length);
+        return frame;
+    }
+
+    /**
+     * @brief Blocking convenience: reads until a whole frame has arrived.
+     * Returns nullopt at EOF, on a socket error or on a corrupt stream.
+     */
+    std::optional<Frame> receiveFrame(int sd)
+    {
+        while(true)
+        {
+            if(std::optional<Frame> frame = nextFrame())
+                return frame;
+            if(corrupt || readFrom(sd) <= 0)
+                return std::nullopt;
+        }
+    }
+
+    /**
+     * @brief Moves up to `max` bytes that were received but not parsed into
+     * `out`, for data that follows a frame unframed (a FILE_DATA body).
+     * Returns the number of bytes moved.
+     */
+    size_t takeBuffered(uint8_t* out, size_t max)
+    {
+        if(!ring)
+            return 0;
+        size_t n = std::min(max, ring->readable());
+        std::memcpy(out, ring->readPtr(), n);
+        ring->consume(n);
+        return n;
+    }
+
+    bool protocolError() const { return corrupt; }
+    uint64_t bytesSent() const { return sent; }
+    uint64_t bytesReceived() const { return received; }
+
+private:
+    //send side
+    std::deque<std::array<uint8_t, FRAME_HEADER_SIZE>> headers; //deque: stable addresses for iov
+    std::vector<iovec> iov;
+    size_t iovIndex = 0;
+    uint64_t sent = 0;
+
+    //receive side; the ring is mapped on first use
+    size_t ringCapacity;
+    std::optional<ReceiveRing> ring;
+    bool corrupt = false;
+    uint64_t received = 0;
+
+    uint32_t peekLength() const
+    {
+        uint32_t length;
+        std::memcpy(&length, ring->readPtr(), 4);
+        return ntohl(length);
+    }
+};
@@ -0,0 +1,157 @@
+#pragma once
+/*------------------------------------------------------------
+        Pipelined request/response client over MessageCodec
+-------------------------------------------------------------*/
+
+#include <chrono>
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include "MessageCodec.h"
+
+/**
+ * @brief Keeps up to `depth` requests in flight on one connection instead
+ * of waiting a full round trip per message.
+ *
+ * Every request is a TEXT frame with its own sequence id, and responses are
+ * matched by that id (not by arrival order). The socket runs with
+ * TCP_NODELAY, so small frames are coalesced explicitly instead of by
+ * Nagle's algorithm:
+ *   NONE   every submit() is its own send(), i.e. one packet per request
+ *   CORK   submit() sends right away, but under TCP_CORK; pump() uncorks,
+ *          so everything submitted in between leaves in full segments
+ *   BATCH  submit() only queues; pump() sends the whole batch with one
+ *          sendmsg() (MSG_MORE on all but the last piece)
+ */
+class PipelinedClient
+{
+public:
+    enum class Coalescing { NONE, CORK, BATCH };
+
+    struct Completion
+    {
+        uint32_t sequence;
+        std::span<const uint8_t> payload;   //valid during the callback only
+        std::chrono::nanoseconds latency;   //submit() to response parsed
+    };
+
+    PipelinedClient(int sd, size_t depth, Coalescing mode = Coalescing::BATCH)
+        : sd(sd), depth(depth), mode(mode)
+    {
+        int one = 1;
+        setsockopt(sd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        fcntl(sd, F_SETFL, fcntl(sd, F_GETFL, 0) | O_NONBLOCK);
+    }
+
+    size_t inFlight() const { return pending.size(); }
+    bool canSubmit() const { return pending.size() < depth; }
+    bool failed() const { return broken; }
+
+    /**
+     * @brief Queues one request and returns its sequence id. The payload is
+     * sent by reference: keep it alive until its response has arrived.
+     * Call only while canSubmit().
+     */
+    uint32_t submit(std::span<const uint8_t> payload)
+    {
+        uint32_t sequence = nextSequence++;
+        pending.emplace(sequence, std::chrono::steady_clock::now());
+        codec.enqueue(MessageType::TEXT, sequence, payload);
+        if(mode == Coalescing::CORK && !corked)
+        {
+            setCork(true);
+        }
+        if(mode != Coalescing::BATCH && !codec.flush(sd))
+        {
+            broken = true;
+        }
+        return sequence;
+    }
+
+    /**
+     * @brief Sends whatever is still queued, waits up to `timeoutMs` for the
+     * socket, and calls onCompletion(const Completion&) for every response
+     * that arrived. Returns false once the connection has failed or closed.
+     */
+    template<typename Callback>
+    bool pump(Callback&& onCompletion, int timeoutMs = -1)
+    {
+        if(broken)
+            return false;
+        if(codec.hasPending() && !codec.flush(sd))
+            return fail();
+        if(corked)
+        {
+            setCork(false); //pushes the partial segment out now
+        }
+
+        pollfd pfd{sd, POLLIN, 0};
+        if(codec.hasPending())
+            pfd.events |= POLLOUT; //socket buffer was full: finish the batch later
+        if(poll(&pfd, 1, timeoutMs) <= 0)
+            return true;
+        if(pfd.revents & POLLOUT)
+        {
+            if(!codec.flush(sd))
+                return fail();
+        }
+        if(pfd.revents & (POLLIN | POLLERR | POLLHUP))
+        {
+            ssize_t n = codec.readFrom(sd);
+            if(n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK))
+                return fail();
+            auto now = std::chrono::steady_clock::now();
+            while(std::optional<Frame> frame = codec.nextFrame())
+            {
+                auto it = pending.find(frame->sequence);
+                if(it == pending.end())
+                    continue; //not ours (or a duplicate): ignore
+                onCompletion(Completion{frame->sequence, frame->payload, now - it->second});
+                pending.erase(it);
+            }
+            if(codec.protocolError())
+                return fail();
+        }
+        return true;
+    }
+
+    /**
+     * @brief Ends the session politely: sends EXIT once nothing is in flight.
+     */
+    void finish()
+    {
+        fcntl(sd, F_SETFL, fcntl(sd, F_GETFL, 0) & ~O_NONBLOCK);
+        codec.enqueue(MessageType::EXIT, nextSequence++);
+        codec.flush(sd);
+    }
+
+    uint64_t bytesSent() const { return codec.bytesSent(); }
+    uint64_t bytesReceived() const { return codec.bytesReceived(); }
+
+private:
+    int sd;
+    size_t depth;
+    Coalescing mode;
+    MessageCodec codec;
+    uint32_t nextSequence = 0;
+    std::unordered_map<uint32_t, std::chrono::steady_clock::time_point> pending; //sequence -> submit time
+    bool corked = false;
+    bool broken = false;
+
+    void setCork(bool on)
+    {
+        int value = on ? 1 : 0;
+        setsockopt(sd, IPPROTO_TCP, TCP_CORK, &value, sizeof(value));
+        corked = on;
+    }
+
+    bool fail()
+    {
+        broken = true;
+        return false;
+    }
+};
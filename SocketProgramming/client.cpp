@@ -20,8 +20,241 @@
 #include <sys/wait.h>
 #include <fcntl.h>
 #include <fstream>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+#include <memory>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <functional>
+#include <netinet/tcp.h>
+#include <sys/stat.h>
+#include "MessageCodec.h"
+#include "PipelinedClient.h"
+#include "FileTransfer.h"
+#include "ConnectionPool.h"
+#include "LatencyHistogram.h"
 using namespace std;
 
+/*
+    --pipeline K: sends every stdin line without waiting for the previous
+    reply, keeping up to K requests in flight. Replies are printed as they
+    arrive, tagged with the sequence id of the request they answer.
+*/
+void runPipelinedSession(int clientSd, size_t depth)
+{
+    PipelinedClient client(clientSd, depth);
+    unordered_map<uint32_t, unique_ptr<string>> lines; //payloads must outlive their request
+    auto onCompletion = [&lines](const PipelinedClient::Completion& done) {
+        cout << "Server [" << done.sequence << "]: "
+             << string_view((const char*)done.payload.data(), done.payload.size())
+             << " (" << done.latency.count() / 1000 << " us)" << endl;
+        lines.erase(done.sequence);
+    };
+    bool inputOpen = true;
+    while(!client.failed() && (inputOpen || client.inFlight() > 0))
+    {
+        string data;
+        if(inputOpen && client.canSubmit() && getline(cin, data) && data != "exit")
+        {
+            auto line = make_unique<string>(std::move(data));
+            uint32_t sequence = client.submit({(const uint8_t*)line->data(), line->size()});
+            lines[sequence] = std::move(line);
+            client.pump(onCompletion, 0);
+            continue;
+        }
+        if(client.canSubmit())
+            inputOpen = false; //EOF or "exit": drain what is still in flight
+        client.pump(onCompletion, 1000);
+    }
+    client.finish();
+    cout << "********Session********" << endl;
+    cout << "Bytes written: " << client.bytesSent() <<
+    " Bytes read: " << client.bytesReceived() << endl;
+}
+
+/*
+    --get REMOTE LOCAL: downloads a file from a server started with --files DIR.
+    The bytes are received straight into a preallocated, memory-mapped file.
+    A whole-file download goes through LOCAL.part and continues where an
+    earlier one stopped (see downloadFile in FileTransfer.h); --offset or
+    --length writes just that range into LOCAL in place (see fetchFile).
+*/
+bool runDownload(int clientSd, const string& remotePath, const string& localPath, optional<uint64_t> offset,
+                 uint64_t length)
+{
+    MessageCodec codec;
+    FileReceipt receipt;
+    string error;
+    auto start = chrono::steady_clock::now();
+    bool ok = offset || length ? fetchFile(clientSd, codec, 0, remotePath, localPath, offset.value_or(0), length, receipt, error)
+                               : downloadFile(clientSd, codec, 0, remotePath, localPath, receipt, error);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    codec.enqueue(MessageType::EXIT, 1);
+    codec.flush(clientSd);
+    if(!ok)
+    {
+        cerr << "Download failed: " << error << endl;
+        return false;
+    }
+    cout << "Received bytes " << receipt.offset << "-" << receipt.offset + receipt.length << " of "
+         << (receipt.fileSize == UNKNOWN_FILE_SIZE ? string("?") : to_string(receipt.fileSize))
+         << " into " << localPath << " (" << receipt.received / max(seconds, 1e-9) / 1e6 << " MB/s)" << endl;
+    return true;
+}
+
+/*
+    --bench-pool: POOL_CALLERS threads each send "ping" requests to a running
+    `server --threads N` and time how long it takes to get a connection for each
+    one: a new connect() per request, a ConnectionPool with one connection per
+    caller, and a pool a quarter of that size (callers queue for connections).
+    Afterwards a small pool shows lazy validation and idle eviction.
+*/
+const int POOL_CALLERS = 64;
+
+struct PoolRun
+{
+    const char* name;
+    LatencyHistogram checkout;
+    uint64_t requests = 0;
+    double seconds = 0;
+    ConnectionPool::Stats stats{};
+};
+
+//one request/response on a connection; false if the connection misbehaved
+bool ping(int sd, MessageCodec& codec, uint32_t sequence)
+{
+    static const string payload = "ping";
+    codec.enqueue(MessageType::TEXT, sequence, payload);
+    if(!codec.flush(sd))
+        return false;
+    optional<Frame> frame = codec.receiveFrame(sd);
+    return frame && frame->sequence == sequence;
+}
+
+void runCallers(PoolRun& run, int requestsPerCaller, const function<bool(int, uint32_t, LatencyHistogram&)>& request)
+{
+    vector<LatencyHistogram> histograms(POOL_CALLERS);
+    vector<uint64_t> done(POOL_CALLERS);
+    vector<thread> callers;
+    auto start = chrono::steady_clock::now();
+    for(int c = 0; c < POOL_CALLERS; c++)
+    {
+        callers.emplace_back([&, c]() {
+            for(int r = 0; r < requestsPerCaller; r++)
+            {
+                done[c] += request(c, r, histograms[c]);
+            }
+        });
+    }
+    for(auto& t : callers)
+        t.join();
+    run.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    for(int c = 0; c < POOL_CALLERS; c++)
+    {
+        run.checkout.merge(histograms[c]);
+        run.requests += done[c];
+    }
+}
+
+void runPoolBenchmark(const sockaddr_in& server)
+{
+    auto elapsedNs = [](chrono::steady_clock::time_point since) {
+        return (uint64_t)chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - since).count();
+    };
+    vector<PoolRun> runs(3);
+
+    runs[0].name = "connect per request";
+    runCallers(runs[0], 50, [&](int, uint32_t sequence, LatencyHistogram& checkout) {
+        auto start = chrono::steady_clock::now();
+        int sd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if(connect(sd, (const sockaddr*)&server, sizeof(server)) < 0)
+        {
+            close(sd);
+            return false;
+        }
+        int one = 1;
+        setsockopt(sd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        checkout.record(elapsedNs(start));
+        MessageCodec codec;
+        bool ok = ping(sd, codec, sequence);
+        //EXIT and wait for the server to close first, so TIME_WAIT stays on its side
+        codec.enqueue(MessageType::EXIT, sequence + 1);
+        codec.flush(sd);
+        char byte;
+        while(recv(sd, &byte, 1, 0) > 0)
+        {
+        }
+        close(sd);
+        return ok;
+    });
+
+    for(int r = 1; r <= 2; r++)
+    {
+        ConnectionPool::Options options;
+        options.minSize = 4;
+        options.maxSize = r == 1 ? POOL_CALLERS : POOL_CALLERS / 4;
+        ConnectionPool pool(server, options);
+        runs[r].name = r == 1 ? "pool, 64 connections" : "pool, 16 connections";
+        runCallers(runs[r], 500, [&](int, uint32_t sequence, LatencyHistogram& checkout) {
+            auto start = chrono::steady_clock::now();
+            ConnectionPool::Lease lease = pool.checkout();
+            checkout.record(elapsedNs(start));
+            if(!lease)
+                return false;
+            if(!ping(lease.sd(), lease.codec(), sequence))
+            {
+                lease.markBroken();
+                return false;
+            }
+            return true;
+        });
+        runs[r].stats = pool.stats();
+    }
+
+    cout << "\n" << POOL_CALLERS << " concurrent callers, one ping per checkout" << endl;
+    cout << "mode                 | checkout p50 us | p99 us | p99.9 us | max us | requests/s | connects | waits" << endl;
+    for(size_t r = 0; r < runs.size(); r++)
+    {
+        const PoolRun& run = runs[r];
+        printf("%-20s | %15.1f | %6.1f | %8.1f | %6.0f | %10.0f | %8llu | %5llu\n", run.name,
+               run.checkout.percentile(0.50) / 1e3, run.checkout.percentile(0.99) / 1e3,
+               run.checkout.percentile(0.999) / 1e3, run.checkout.largest() / 1e3, run.requests / run.seconds,
+               (unsigned long long)(r == 0 ? run.requests : run.stats.opened), (unsigned long long)run.stats.waits);
+    }
+
+    //lazy validation and idle eviction on a small pool
+    ConnectionPool::Options options;
+    options.minSize = 2;
+    options.maxSize = 8;
+    options.idleTimeout = chrono::milliseconds(200);
+    options.validateAfter = chrono::milliseconds(50);
+    ConnectionPool pool(server, options);
+    {
+        vector<ConnectionPool::Lease> leases;
+        for(int i = 0; i < 8; i++)
+            leases.push_back(pool.checkout());
+    }
+    cout << "\nsmall pool grown to " << pool.size() << " connections" << endl;
+    {
+        //the server closes this one while it sits idle in the pool
+        ConnectionPool::Lease lease = pool.checkout();
+        lease.codec().enqueue(MessageType::EXIT, 0);
+        lease.codec().flush(lease.sd());
+    }
+    this_thread::sleep_for(chrono::milliseconds(100));
+    {
+        ConnectionPool::Lease lease = pool.checkout();
+        cout << "after the server dropped one: checkout " << (lease && ping(lease.sd(), lease.codec(), 1) ? "ok" : "FAILED")
+             << ", failed health checks " << pool.stats().failedChecks << ", size " << pool.size() << endl;
+    }
+    this_thread::sleep_for(chrono::milliseconds(300));
+    pool.evictIdle();
+    cout << "after " << options.idleTimeout.count() << " ms idle: size " << pool.size()
+         << " (min " << options.minSize << "), evicted " << pool.stats().evicted << endl;
+}
+
 int main(int argc, char *argv[])
 {
         /* ---------- INITIALIZING VARIABLES ---------- */
@@ -34,8 +267,8 @@ int main(int argc, char *argv[])
        the accepts connections
        3. isExit is bool variable which will be used to 
        end the loop
-       4. The client reads characters from the socket 
-       connection into a dynamic variable (buffer).
+       4. The client sends and receives length-prefixed frames
+       through a MessageCodec (see MessageCodec.h).
        5. A sockaddr_in is a structure containing an internet 
        address. This structure is already defined in netinet/in.h, so
        we don't need to declare it again.
@@ -54,13 +287,38 @@ int main(int argc, char *argv[])
 
     // NOTE that the port number is same for both client and server
 //     bool isExit = false;
-    if(argc != 3)
+    size_t pipelineDepth = 0;
+    string remotePath, localPath;
+    optional<uint64_t> offset;
+    uint64_t length = 0;
+    bool benchPool = false;
+    vector<char*> positional;
+    for(int i = 1; i < argc; i++)
     {
-        cerr << "Usage: ip_address port" << endl; exit(0); 
+        string arg = argv[i];
+        if(arg == "--pipeline" && i + 1 < argc)
+            pipelineDepth = max(1, atoi(argv[++i]));
+        else if(arg == "--get" && i + 2 < argc)
+        {
+            remotePath = argv[++i];
+            localPath = argv[++i];
+        }
+        else if(arg == "--offset" && i + 1 < argc)
+            offset = strtoull(argv[++i], NULL, 10);
+        else if(arg == "--length" && i + 1 < argc)
+            length = strtoull(argv[++i], NULL, 10);
+        else if(arg == "--bench-pool")
+            benchPool = true;
+        else
+            positional.push_back(argv[i]);
+    }
+    if(positional.size() != 2)
+    {
+        cerr << "Usage: [--pipeline K | --get REMOTE LOCAL [--offset N] [--length N] | --bench-pool] ip_address port" << endl; exit(0); 
     } //grab the IP address and port number 
-    char *serverIp = argv[1]; int port = atoi(argv[2]); 
-    //create a message buffer 
-    char msg[1500]; 
+    char *serverIp = positional[0]; int port = atoi(positional[1]); 
+    //frames messages of any length (no fixed-size buffer)
+    MessageCodec codec;
     //setup a socket and connection tools 
     struct hostent* host = gethostbyname(serverIp); 
     sockaddr_in sendSockAddr;   
@@ -69,6 +327,11 @@ int main(int argc, char *argv[])
     sendSockAddr.sin_addr.s_addr = 
         inet_addr(inet_ntoa(*(struct in_addr*)*host->h_addr_list));
     sendSockAddr.sin_port = htons(port);
+    if(benchPool)
+    {
+        runPoolBenchmark(sendSockAddr);
+        return 0;
+    }
     int clientSd = socket(AF_INET, SOCK_STREAM, 0);
     //try to connect...
     int status = connect(clientSd,
@@ -88,7 +351,20 @@ int main(int argc, char *argv[])
         cout<<"Error connecting to socket!"<<endl; 
     }
     cout << "Connected to the server!" << endl;
-    int bytesRead, bytesWritten = 0;
+    if(!remotePath.empty())
+    {
+        bool ok = runDownload(clientSd, remotePath, localPath, offset, length);
+        close(clientSd);
+        return ok ? 0 : 1;
+    }
+    if(pipelineDepth > 0)
+    {
+        runPipelinedSession(clientSd, pipelineDepth);
+        close(clientSd);
+        cout << "Connection closed" << endl;
+        return 0;
+    }
+    uint32_t sequence = 0;
     struct timeval start1, end1;
     gettimeofday(&start1, NULL);
     while(1)
@@ -96,29 +372,28 @@ int main(int argc, char *argv[])
         cout << ">";
         string data;
         getline(cin, data);
-        memset(&msg, 0, sizeof(msg));//clear the buffer
-        strcpy(msg, data.c_str());
         if(data == "exit")
         {
-            send(clientSd, (char*)&msg, strlen(msg), 0);
+            codec.enqueue(MessageType::EXIT, sequence++);
+            codec.flush(clientSd);
             break;
         }
-        bytesWritten += send(clientSd, (char*)&msg, strlen(msg), 0);
+        codec.enqueue(MessageType::TEXT, sequence++, data);
+        codec.flush(clientSd);
         cout << "Awaiting server response..." << endl;
-        memset(&msg, 0, sizeof(msg));//clear the buffer
-        bytesRead += recv(clientSd, (char*)&msg, sizeof(msg), 0);
-        if(!strcmp(msg, "exit"))
+        optional<Frame> frame = codec.receiveFrame(clientSd);
+        if(!frame || frame->type == MessageType::EXIT)
         {
             cout << "Server has quit the session" << endl;
             break;
         }
-        cout << "Server: " << msg << endl;
+        cout << "Server: " << string_view((const char*)frame->payload.data(), frame->payload.size()) << endl;
     }
     gettimeofday(&end1, NULL);
     close(clientSd);
     cout << "********Session********" << endl;
-    cout << "Bytes written: " << bytesWritten << 
-    " Bytes read: " << bytesRead << endl;
+    cout << "Bytes written: " << codec.bytesSent() << 
+    " Bytes read: " << codec.bytesReceived() << endl;
     cout << "Elapsed time: " << (end1.tv_sec- start1.tv_sec) 
       << " secs" << endl;
     cout << "Connection closed" << endl;
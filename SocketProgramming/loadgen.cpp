@@ -0,0 +1,190 @@
+/*------------------------------------------------------------
+                 Pipelined load generator
+-------------------------------------------------------------*/
+
+#include <iostream>
+#include <string>
+#include <stdio.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <string.h>
+#include <netdb.h>
+#include <array>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include "MessageCodec.h"
+#include "PipelinedClient.h"
+#include "LatencyHistogram.h"
+using namespace std;
+
+/* ---------- USAGE ---------------------------------------------------------------------*
+    loadgen ip_address port [--connections C] [--seconds S] [--payload B]
+
+    Drives a running `server --threads N port` with pipelined TEXT frames. For every
+    pipeline depth 1, 2, 4, ... 256 each connection keeps that many requests in flight
+    for S seconds and the generator reports requests/sec and the latency distribution
+    (submit to response, p50/p99/p99.9). A second table compares the ways of coalescing
+    small writes (one send per request, TCP_CORK, one batched sendmsg) at depth 64,
+    including how many requests shared one TCP data segment.
+*--------------------------------------------------------------------------------------*/
+
+//glibc's tcp_info stops at tcpi_total_retrans; the kernel appends more counters
+struct TcpInfoExtended
+{
+    tcp_info base;
+    uint64_t pacingRate;
+    uint64_t maxPacingRate;
+    uint64_t bytesAcked;
+    uint64_t bytesReceived;
+    uint32_t segsOut;
+    uint32_t segsIn;
+    uint32_t notsentBytes;
+    uint32_t minRtt;
+    uint32_t dataSegsIn;
+    uint32_t dataSegsOut;
+};
+
+uint32_t dataSegmentsSent(int sd)
+{
+    TcpInfoExtended info{};
+    socklen_t length = sizeof(info);
+    if(getsockopt(sd, IPPROTO_TCP, TCP_INFO, &info, &length) < 0 ||
+       length < offsetof(TcpInfoExtended, dataSegsOut) + sizeof(uint32_t))
+        return 0; //older kernel: not reported
+    return info.dataSegsOut;
+}
+
+struct RunResult
+{
+    uint64_t requests = 0;
+    uint64_t segments = 0;
+    LatencyHistogram latency;
+};
+
+void runConnection(const sockaddr_in& server, size_t depth, PipelinedClient::Coalescing mode,
+                   const vector<uint8_t>& payload, double seconds, RunResult& result)
+{
+    int sd = socket(AF_INET, SOCK_STREAM, 0);
+    if(connect(sd, (const sockaddr*)&server, sizeof(server)) < 0)
+    {
+        cerr << "Error connecting to socket!" << endl;
+        close(sd);
+        return;
+    }
+    PipelinedClient client(sd, depth, mode);
+    auto onCompletion = [&result](const PipelinedClient::Completion& done) {
+        result.latency.record(done.latency.count());
+        result.requests++;
+    };
+
+    auto deadline = chrono::steady_clock::now() + chrono::duration<double>(seconds);
+    while(chrono::steady_clock::now() < deadline && !client.failed())
+    {
+        //refill the window, then send the batch and collect what came back
+        while(client.canSubmit())
+            client.submit(payload);
+        client.pump(onCompletion, 100);
+    }
+    //let the window drain so every submitted request is accounted for
+    while(client.inFlight() > 0 && client.pump(onCompletion, 1000))
+    {
+    }
+    result.segments = dataSegmentsSent(sd);
+    client.finish();
+    close(sd);
+}
+
+RunResult runLoad(const sockaddr_in& server, int connections, size_t depth, PipelinedClient::Coalescing mode,
+                  const vector<uint8_t>& payload, double seconds, double& elapsed)
+{
+    vector<RunResult> results(connections);
+    vector<thread> threads;
+    auto start = chrono::steady_clock::now();
+    for(int c = 0; c < connections; c++)
+        threads.emplace_back(runConnection, cref(server), depth, mode, cref(payload), seconds, ref(results[c]));
+    for(auto& t : threads)
+        t.join();
+    elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    RunResult total;
+    for(const RunResult& r : results)
+    {
+        total.requests += r.requests;
+        total.segments += r.segments;
+        total.latency.merge(r.latency);
+    }
+    return total;
+}
+
+int main(int argc, char *argv[])
+{
+    if(argc < 3)
+    {
+        cerr << "Usage: ip_address port [--connections C] [--seconds S] [--payload B]" << endl;
+        exit(0);
+    }
+    int connections = 1;
+    double seconds = 1.0;
+    size_t payloadSize = 64;
+    for(int i = 3; i + 1 < argc; i += 2)
+    {
+        string arg = argv[i];
+        if(arg == "--connections")
+            connections = max(1, atoi(argv[i + 1]));
+        else if(arg == "--seconds")
+            seconds = atof(argv[i + 1]);
+        else if(arg == "--payload")
+            payloadSize = (size_t)atol(argv[i + 1]);
+    }
+
+    struct hostent* host = gethostbyname(argv[1]);
+    if(host == NULL)
+    {
+        cerr << "Unknown host " << argv[1] << endl;
+        exit(0);
+    }
+    sockaddr_in server;
+    bzero((char*)&server, sizeof(server));
+    server.sin_family = AF_INET;
+    server.sin_addr = *(struct in_addr*)*host->h_addr_list;
+    server.sin_port = htons(atoi(argv[2]));
+
+    vector<uint8_t> payload(payloadSize, 'x');
+    cout << "=> " << connections << " connection(s), " << payloadSize << "-byte payloads, "
+         << seconds << " s per run" << endl;
+
+    cout << "\ndepth |  requests/s | p50 us | p99 us | p99.9 us | max us" << endl;
+    for(size_t depth = 1; depth <= 256; depth *= 2)
+    {
+        double elapsed;
+        RunResult r = runLoad(server, connections, depth, PipelinedClient::Coalescing::BATCH, payload, seconds, elapsed);
+        printf("%5zu | %11.0f | %6.1f | %6.1f | %8.1f | %6.1f\n", depth, r.requests / elapsed,
+               r.latency.percentile(0.50) / 1e3, r.latency.percentile(0.99) / 1e3,
+               r.latency.percentile(0.999) / 1e3, r.latency.largest() / 1e3);
+    }
+
+    const size_t COMPARE_DEPTH = 64;
+    cout << "\ncoalescing (depth " << COMPARE_DEPTH << ") |  requests/s | p50 us | p99 us | requests per data segment" << endl;
+    const pair<const char*, PipelinedClient::Coalescing> modes[] = {
+        {"one send per request  ", PipelinedClient::Coalescing::NONE},
+        {"TCP_CORK              ", PipelinedClient::Coalescing::CORK},
+        {"batched sendmsg       ", PipelinedClient::Coalescing::BATCH},
+    };
+    for(const auto& [name, mode] : modes)
+    {
+        double elapsed;
+        RunResult r = runLoad(server, connections, COMPARE_DEPTH, mode, payload, seconds, elapsed);
+        printf("%s| %11.0f | %6.1f | %6.1f | %s\n", name, r.requests / elapsed,
+               r.latency.percentile(0.50) / 1e3, r.latency.percentile(0.99) / 1e3,
+               r.segments ? to_string((double)r.requests / r.segments).substr(0, 5).c_str() : "n/a");
+    }
+    return 0;
+}
@@ -20,21 +20,30 @@
 #include <sys/wait.h>
 #include <fcntl.h>
 #include <fstream>
+#include <sys/epoll.h>
+#include <netinet/tcp.h>
+#include <errno.h>
+#include <signal.h>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <unordered_map>
+#include <optional>
+#include <string_view>
+#include <pthread.h>
+#include <time.h>
+#include <sys/resource.h>
+#include "MessageCodec.h"
+#include "FileTransfer.h"
 using namespace std;
 
 
-int main(int argc, char *argv[])
+void runInteractiveServer(int port)
 {
-    //for the server, we only need to specify a port number
-    if(argc != 2)
-    {
-        cerr << "Usage: port" << endl;
-        exit(0);
-    }
-
-    int port = atoi(argv[1]); //grab the port number
-
-    char msg[1500]; //buffer to send and receive messages with
+    MessageCodec codec; //frames messages of any length (no fixed-size buffer)
      
     //setup a socket and connection tools
     struct sockaddr_in servAddr;
@@ -108,42 +117,1049 @@ cout << "\n=> Socket server has been created..." << endl;
     //lets keep track of the session time
     struct timeval start1, end1;
     gettimeofday(&start1, NULL);
-    //also keep track of the amount of data sent as well
-    int bytesRead, bytesWritten = 0;
+    //the codec also keeps track of the amount of data sent and received
+    uint32_t sequence = 0;
     while(1)
     {
         //receive a message from the client (listen)
         cout << "Awaiting client response..." << endl;
-        memset(&msg, 0, sizeof(msg));//clear the buffer
-        bytesRead += recv(newSd, (char*)&msg, sizeof(msg), 0);
-        if(!strcmp(msg, "exit"))
+        optional<Frame> frame = codec.receiveFrame(newSd);
+        if(!frame || frame->type == MessageType::EXIT)
         {
             cout << "Client has quit the session" << endl;
             break;
         }
-        cout << "Client: " << msg << endl;
+        cout << "Client: " << string_view((const char*)frame->payload.data(), frame->payload.size()) << endl;
         cout << ">";
         string data;
         getline(cin, data);
-        memset(&msg, 0, sizeof(msg)); //clear the buffer
-        strcpy(msg, data.c_str());
         if(data == "exit")
         {
-            //send to the client that server has closed the connection
-            send(newSd, (char*)&msg, strlen(msg), 0);
+            //tell the client that server has closed the connection
+            codec.enqueue(MessageType::EXIT, sequence++);
+            codec.flush(newSd);
             break;
         }
         //send the message to client
-        bytesWritten += send(newSd, (char*)&msg, strlen(msg), 0);
+        codec.enqueue(MessageType::TEXT, sequence++, data);
+        codec.flush(newSd);
     }
     //we need to close the socket descriptors after we're all done
     gettimeofday(&end1, NULL);
     close(newSd);
     close(serverSd);
     cout << "********Session********" << endl;
-    cout << "Bytes written: " << bytesWritten << " Bytes read: " << bytesRead << endl;
+    cout << "Bytes written: " << codec.bytesSent() << " Bytes read: " << codec.bytesReceived() << endl;
     cout << "Elapsed time: " << (end1.tv_sec - start1.tv_sec) 
         << " secs" << endl;
     cout << "Connection closed..." << endl;
-    return 0;   
-}
\ No newline at end of file
+}
+
+/* ---------- MULTI-THREADED SERVER MODE ----------------------------------------------*
+    server --threads N [--backlog B] [--files DIR] port
+
+    The interactive server above can only talk to one client. In this mode the server
+    runs N event-loop threads. Every thread opens its OWN listening socket on the same
+    port (SO_REUSEPORT) and its own epoll instance, so the kernel hashes incoming
+    connections across the threads: there is no shared accept queue or accept lock,
+    and a connection stays on the thread that accepted it for its whole life.
+
+    Every connection is a small state machine driven by epoll readiness:
+        READING  --(complete frame(s) received, echoes queued)--> WRITING
+        WRITING  --(echoes fully sent)----------------------------> READING
+        any      --(EXIT frame, EOF, error, corrupt frame)---------> CLOSED
+    A connection in READING only waits for EPOLLIN and one in WRITING only for
+    EPOLLOUT, so a slow reader cannot make the server buffer without bound.
+    Each TEXT frame is echoed back; EXIT ends the session as in the interactive
+    mode. The echoes are sent straight out of the receive ring (the payload is
+    never copied), which is safe because nothing is read while WRITING.
+
+    With --files DIR a FILE_REQUEST frame is answered with a byte range of a file
+    below DIR (see FileTransfer.h). The connection stays in WRITING until the FILE_DATA
+    header and the whole range have been sent with sendfile/splice; frames pipelined
+    behind the request wait in the ring and are answered afterwards, in order. A pipe
+    or device source that has no data yet is put into the epoll set itself (tagged
+    with the connection), so a slow source never blocks the loop.
+*------------------------------------------------------------------------------------*/
+
+static atomic<bool> stopRequested{false};
+
+void onStopSignal(int)
+{
+    stopRequested.store(true);
+}
+
+//opens a non-blocking listening socket that shares its port with the other loops
+//(port 0 picks a free port; the other loops then bind to the port it got)
+int makeReusePortListener(int port, int backlog)
+{
+    int sd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if(sd < 0)
+    {
+        return -1;
+    }
+    int one = 1;
+    setsockopt(sd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    setsockopt(sd, SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one));
+
+    sockaddr_in addr;
+    bzero((char*)&addr, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(port);
+    //the kernel silently caps the backlog at net.core.somaxconn
+    if(bind(sd, (sockaddr*)&addr, sizeof(addr)) < 0 || listen(sd, backlog) < 0)
+    {
+        close(sd);
+        return -1;
+    }
+    return sd;
+}
+
+int boundPort(int sd)
+{
+    sockaddr_in addr;
+    socklen_t len = sizeof(addr);
+    getsockname(sd, (sockaddr*)&addr, &len);
+    return ntohs(addr.sin_port);
+}
+
+enum class ConnState { READING, WRITING, CLOSED };
+
+struct Connection
+{
+    int sd;
+    ConnState state = ConnState::READING;
+    MessageCodec codec;     //receive ring + queued echoes
+    bool closeAfterWrite = false;
+    uint32_t watching = EPOLLIN;
+    //file request in progress; later frames stay in the ring until it is done
+    unique_ptr<FileSender> file;
+    array<uint8_t, FILE_DATA_HEADER_SIZE> fileHeader;
+    string errorReply;
+    bool framesWaiting = false;
+    bool sourceWatched = false;
+};
+
+//epoll tags: the socket itself, or the pipe/device a file transfer is waiting on
+const uint64_t SOURCE_TAG = uint64_t(1) << 32;
+
+class EventLoop
+{
+public:
+    //filesRootFd: directory FILE_REQUESTs are served from (-1: file serving disabled)
+    EventLoop(int listenSd, int filesRootFd = -1, FileSender::Method fileMethod = FileSender::Method::AUTO)
+        : listenSd(listenSd), filesRootFd(filesRootFd), fileMethod(fileMethod)
+    {
+        epollFd = epoll_create1(EPOLL_CLOEXEC);
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.u64 = listenSd;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, listenSd, &ev);
+    }
+
+    ~EventLoop()
+    {
+        stop();
+        for(auto& entry : conns)
+        {
+            close(entry.first);
+        }
+        close(epollFd);
+        close(listenSd);
+    }
+
+    void start()
+    {
+        worker = thread([this]() { run(); });
+    }
+
+    void stop()
+    {
+        stopping.store(true);
+        if(worker.joinable())
+        {
+            worker.join();
+        }
+    }
+
+    uint64_t acceptedCount() const { return accepted.load(memory_order_relaxed); }
+    uint64_t requestCount() const { return requests.load(memory_order_relaxed); }
+
+    //CPU time used by the loop thread so far (call while it is running)
+    double cpuSeconds()
+    {
+        clockid_t clock;
+        timespec ts{};
+        if(pthread_getcpuclockid(worker.native_handle(), &clock) == 0)
+        {
+            clock_gettime(clock, &ts);
+        }
+        return ts.tv_sec + ts.tv_nsec / 1e9;
+    }
+
+private:
+    int listenSd;
+    int filesRootFd;
+    FileSender::Method fileMethod;
+    int epollFd;
+    thread worker;
+    atomic<bool> stopping{false};
+    atomic<uint64_t> accepted{0};
+    atomic<uint64_t> requests{0};
+    unordered_map<int, Connection> conns; //only touched by this loop's thread
+
+    void run()
+    {
+        epoll_event events[256];
+        while(!stopping.load(memory_order_relaxed) && !stopRequested.load(memory_order_relaxed))
+        {
+            int n = epoll_wait(epollFd, events, 256, 100);
+            for(int i = 0; i < n; i++)
+            {
+                int sd = static_cast<int>(events[i].data.u64 & 0xffffffff);
+                bool fromSource = (events[i].data.u64 & SOURCE_TAG) != 0;
+                if(sd == listenSd)
+                {
+                    acceptAll();
+                    continue;
+                }
+                auto it = conns.find(sd);
+                if(it == conns.end())
+                {
+                    continue;
+                }
+                Connection& conn = it->second;
+                if(fromSource)
+                {
+                    //the file's source has data (or hung up, which pump() reports)
+                    if(conn.state == ConnState::WRITING && conn.file)
+                    {
+                        onWritable(conn);
+                    }
+                }
+                else if(events[i].events & (EPOLLERR | EPOLLHUP))
+                {
+                    conn.state = ConnState::CLOSED;
+                }
+                else if(conn.state == ConnState::READING && (events[i].events & EPOLLIN))
+                {
+                    onReadable(conn);
+                }
+                else if(conn.state == ConnState::WRITING && (events[i].events & EPOLLOUT))
+                {
+                    onWritable(conn);
+                }
+                if(conn.state == ConnState::CLOSED)
+                {
+                    close(sd); //also removes it from the epoll set
+                    conns.erase(it);
+                }
+            }
+        }
+    }
+
+    void acceptAll()
+    {
+        while(true)
+        {
+            int sd = accept4(listenSd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if(sd < 0)
+            {
+                return; //EAGAIN: backlog drained (or a transient error; epoll will retry)
+            }
+            int one = 1;
+            setsockopt(sd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+            epoll_event ev{};
+            ev.events = EPOLLIN;
+            ev.data.u64 = sd;
+            epoll_ctl(epollFd, EPOLL_CTL_ADD, sd, &ev);
+            conns[sd].sd = sd;
+            accepted.fetch_add(1, memory_order_relaxed);
+        }
+    }
+
+    void onReadable(Connection& conn)
+    {
+        //one recv per wake-up: the echoes below point into the ring, so it must
+        //not be refilled before they are sent (level-triggered epoll calls us again)
+        ssize_t n = conn.codec.readFrom(conn.sd);
+        if(n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK))
+        {
+            conn.state = ConnState::CLOSED; //client went away
+            return;
+        }
+        processFrames(conn);
+    }
+
+    void processFrames(Connection& conn)
+    {
+        //every TEXT frame is one request; pipelined requests are answered in order
+        conn.framesWaiting = false;
+        while(optional<Frame> frame = conn.codec.nextFrame())
+        {
+            if(frame->type == MessageType::EXIT)
+            {
+                conn.closeAfterWrite = true;
+                break;
+            }
+            requests.fetch_add(1, memory_order_relaxed);
+            if(frame->type == MessageType::FILE_REQUEST)
+            {
+                startFile(conn, *frame);
+                conn.framesWaiting = true; //the rest once the file is out
+                break;
+            }
+            conn.codec.enqueue(frame->type, frame->sequence, frame->payload, frame->flags);
+        }
+        if(conn.codec.protocolError())
+        {
+            conn.state = ConnState::CLOSED;
+            return;
+        }
+
+        if(!conn.codec.hasPending())
+        {
+            if(conn.closeAfterWrite)
+            {
+                conn.state = ConnState::CLOSED;
+                return;
+            }
+            conn.state = ConnState::READING;
+            watch(conn, EPOLLIN);
+            return;
+        }
+        conn.state = ConnState::WRITING;
+        onWritable(conn); //most replies fit in the socket buffer right away
+    }
+
+    //queues the FILE_DATA header (or an ERROR) and opens the range to stream after it
+    void startFile(Connection& conn, const Frame& request)
+    {
+        string error;
+        if(filesRootFd < 0)
+        {
+            error = "file serving is disabled (start the server with --files DIR)";
+        }
+        else if(request.payload.size() < 16)
+        {
+            error = "malformed file request";
+        }
+        else
+        {
+            string_view path((const char*)request.payload.data() + 16, request.payload.size() - 16);
+            conn.file = make_unique<FileSender>();
+            error = conn.file->open(filesRootFd, path, getU64(request.payload.data()),
+                                    getU64(request.payload.data() + 8), fileMethod);
+        }
+        if(!error.empty())
+        {
+            conn.file.reset();
+            conn.errorReply = std::move(error);
+            conn.codec.enqueue(MessageType::ERROR, request.sequence, conn.errorReply);
+            return;
+        }
+        conn.fileHeader = conn.file->header();
+        conn.codec.enqueue(MessageType::FILE_DATA, request.sequence, conn.fileHeader);
+    }
+
+    void onWritable(Connection& conn)
+    {
+        //a file body follows the header: let it share the header's segment
+        if(!conn.codec.flush(conn.sd, conn.file && conn.file->bytesLeft() > 0))
+        {
+            conn.state = ConnState::CLOSED;
+            return;
+        }
+        if(conn.codec.hasPending())
+        {
+            watch(conn, EPOLLOUT); //still WRITING
+            return;
+        }
+        if(conn.file)
+        {
+            switch(conn.file->pump(conn.sd))
+            {
+            case FileSender::Progress::DONE:
+                conn.file.reset(); //closes the source, which also leaves the epoll set
+                conn.sourceWatched = false;
+                break;
+            case FileSender::Progress::WAIT_SOCKET:
+                watchSource(conn, false);
+                watch(conn, EPOLLOUT);
+                return;
+            case FileSender::Progress::WAIT_SOURCE:
+                watch(conn, 0); //errors and hang-ups are still reported
+                watchSource(conn, true);
+                return;
+            case FileSender::Progress::FAILED:
+                conn.state = ConnState::CLOSED;
+                return;
+            }
+        }
+        if(conn.closeAfterWrite)
+        {
+            conn.state = ConnState::CLOSED;
+            return;
+        }
+        if(conn.framesWaiting)
+        {
+            processFrames(conn); //requests that arrived behind the file request
+            return;
+        }
+        conn.state = ConnState::READING;
+        watch(conn, EPOLLIN);
+    }
+
+    void watch(Connection& conn, uint32_t events)
+    {
+        if(conn.watching == events)
+        {
+            return;
+        }
+        epoll_event ev{};
+        ev.events = events;
+        ev.data.u64 = conn.sd;
+        epoll_ctl(epollFd, EPOLL_CTL_MOD, conn.sd, &ev);
+        conn.watching = events;
+    }
+
+    //adds/removes the pipe or device a transfer reads from; removed rather than
+    //masked while the socket is full, since a hung-up source is always reported
+    void watchSource(Connection& conn, bool on)
+    {
+        if(conn.sourceWatched == on || !conn.file->pollableSource())
+        {
+            return;
+        }
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.u64 = SOURCE_TAG | static_cast<uint32_t>(conn.sd);
+        epoll_ctl(epollFd, on ? EPOLL_CTL_ADD : EPOLL_CTL_DEL, conn.file->sourceFd(), &ev);
+        conn.sourceWatched = on;
+    }
+};
+
+//opens `threads` SO_REUSEPORT listeners on one port; returns false if any bind fails
+bool openEventLoops(int& port, int threads, int backlog, vector<unique_ptr<EventLoop>>& loops,
+                    int filesRootFd = -1, FileSender::Method fileMethod = FileSender::Method::AUTO)
+{
+    for(int t = 0; t < threads; t++)
+    {
+        int sd = makeReusePortListener(port, backlog);
+        if(sd < 0)
+        {
+            loops.clear();
+            return false;
+        }
+        port = boundPort(sd);
+        loops.push_back(make_unique<EventLoop>(sd, filesRootFd, fileMethod));
+    }
+    for(auto& loop : loops)
+    {
+        loop->start();
+    }
+    return true;
+}
+
+void runThreadedServer(int port, int threads, int backlog, const string& filesDir)
+{
+    signal(SIGINT, onStopSignal);
+    signal(SIGTERM, onStopSignal);
+
+    int filesRootFd = -1;
+    if(!filesDir.empty())
+    {
+        filesRootFd = open(filesDir.c_str(), O_PATH | O_DIRECTORY | O_CLOEXEC);
+        if(filesRootFd < 0)
+        {
+            cerr << "Cannot open file root " << filesDir << ": " << strerror(errno) << endl;
+            exit(0);
+        }
+    }
+
+    vector<unique_ptr<EventLoop>> loops;
+    if(!openEventLoops(port, threads, backlog, loops, filesRootFd))
+    {
+        cerr << "Error binding SO_REUSEPORT listeners to port " << port << endl;
+        exit(0);
+    }
+    cout << "\n=> " << threads << " event loops listening on port " << port
+         << " (backlog " << backlog << "), Ctrl+C to stop..." << endl;
+
+    while(!stopRequested.load())
+    {
+        this_thread::sleep_for(chrono::milliseconds(100));
+    }
+
+    cout << "\n********Session********" << endl;
+    for(size_t t = 0; t < loops.size(); t++)
+    {
+        loops[t]->stop();
+        cout << "Loop " << t << ": accepted " << loops[t]->acceptedCount()
+             << " connections, answered " << loops[t]->requestCount() << " requests" << endl;
+    }
+    if(filesRootFd >= 0)
+    {
+        close(filesRootFd);
+    }
+    cout << "Server stopped..." << endl;
+}
+
+/* ---------- LOOPBACK LOAD GENERATOR -------------------------------------------------*
+    server --bench [--backlog B] [--seconds S]
+
+    Starts the multi-threaded server with 1, 2, 4 and 8 event loops and drives it from
+    client threads on 127.0.0.1. Every client connection sends REQUESTS_PER_CONNECTION
+    "ping" frames one at a time (waiting for each echo), then an EXIT frame, and
+    reconnects once the server has closed it. Because the server closes first, TIME_WAIT stays on
+    the server side and the generator does not run out of ephemeral ports.
+*------------------------------------------------------------------------------------*/
+
+const int GENERATOR_THREADS = 4;
+const int CONNECTIONS_PER_GENERATOR = 64;
+const int REQUESTS_PER_CONNECTION = 16;
+
+struct LoadConnection
+{
+    int sd = -1;
+    int repliesLeft = 0;
+    bool exiting = false;
+};
+
+void openLoadConnection(int epollFd, const sockaddr_in& server, LoadConnection& conn)
+{
+    conn.sd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    conn.repliesLeft = REQUESTS_PER_CONNECTION;
+    conn.exiting = false;
+    int one = 1;
+    setsockopt(conn.sd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    connect(conn.sd, (const sockaddr*)&server, sizeof(server)); //EINPROGRESS
+    epoll_event ev{};
+    ev.events = EPOLLOUT; //writable once connected
+    ev.data.ptr = &conn;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, conn.sd, &ev);
+}
+
+void generateLoad(const sockaddr_in& server, const atomic<bool>& running)
+{
+    int epollFd = epoll_create1(EPOLL_CLOEXEC);
+    vector<LoadConnection> conns(CONNECTIONS_PER_GENERATOR);
+    for(auto& conn : conns)
+    {
+        openLoadConnection(epollFd, server, conn);
+    }
+
+    //both frames are tiny and fixed, so they are encoded once up front
+    uint8_t ping[FRAME_HEADER_SIZE + 4];
+    encodeFrameHeader(ping, MessageType::TEXT, 0, 4);
+    memcpy(ping + FRAME_HEADER_SIZE, "ping", 4);
+    uint8_t bye[FRAME_HEADER_SIZE];
+    encodeFrameHeader(bye, MessageType::EXIT, 0, 0);
+    epoll_event events[CONNECTIONS_PER_GENERATOR];
+    while(running.load(memory_order_relaxed))
+    {
+        int n = epoll_wait(epollFd, events, CONNECTIONS_PER_GENERATOR, 50);
+        for(int i = 0; i < n; i++)
+        {
+            LoadConnection& conn = *(LoadConnection*)events[i].data.ptr;
+            bool reopen = false;
+            if(events[i].events & EPOLLOUT)
+            {
+                //connected: send the first request and wait for replies from now on
+                epoll_event ev{};
+                ev.events = EPOLLIN;
+                ev.data.ptr = &conn;
+                epoll_ctl(epollFd, EPOLL_CTL_MOD, conn.sd, &ev);
+                reopen = send(conn.sd, ping, sizeof(ping), MSG_NOSIGNAL) != (ssize_t)sizeof(ping);
+            }
+            else if(events[i].events & (EPOLLIN | EPOLLERR | EPOLLHUP))
+            {
+                char reply[64];
+                ssize_t got = recv(conn.sd, reply, sizeof(reply), 0);
+                if(got <= 0)
+                {
+                    reopen = true; //server closed after EXIT (or refused us)
+                }
+                else if(!conn.exiting)
+                {
+                    //a 16-byte echo always arrives in one piece on loopback
+                    if(--conn.repliesLeft > 0)
+                    {
+                        reopen = send(conn.sd, ping, sizeof(ping), MSG_NOSIGNAL) != (ssize_t)sizeof(ping);
+                    }
+                    else
+                    {
+                        conn.exiting = true;
+                        reopen = send(conn.sd, bye, sizeof(bye), MSG_NOSIGNAL) != (ssize_t)sizeof(bye);
+                    }
+                }
+            }
+            if(reopen)
+            {
+                close(conn.sd);
+                openLoadConnection(epollFd, server, conn);
+            }
+        }
+    }
+    for(auto& conn : conns)
+    {
+        close(conn.sd);
+    }
+    close(epollFd);
+}
+
+void runLoadBenchmark(int backlog, double seconds)
+{
+    cout << "\n=> Loopback load: " << GENERATOR_THREADS << " generator threads x "
+         << CONNECTIONS_PER_GENERATOR << " connections, " << REQUESTS_PER_CONNECTION
+         << " requests per connection, backlog " << backlog << ", "
+         << thread::hardware_concurrency() << " CPUs" << endl;
+
+    struct Row
+    {
+        int threads;
+        double connectionsPerSec;
+        double requestsPerSec;
+        uint64_t minShare;
+        uint64_t maxShare;
+    };
+    vector<Row> rows;
+
+    for(int threads : {1, 2, 4, 8})
+    {
+        int port = 0;
+        vector<unique_ptr<EventLoop>> loops;
+        if(!openEventLoops(port, threads, backlog, loops))
+        {
+            cerr << "Error opening SO_REUSEPORT listeners" << endl;
+            return;
+        }
+
+        sockaddr_in server;
+        bzero((char*)&server, sizeof(server));
+        server.sin_family = AF_INET;
+        server.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        server.sin_port = htons(port);
+
+        atomic<bool> running{true};
+        vector<thread> generators;
+        auto start = chrono::steady_clock::now();
+        for(int g = 0; g < GENERATOR_THREADS; g++)
+        {
+            generators.emplace_back(generateLoad, cref(server), cref(running));
+        }
+        this_thread::sleep_for(chrono::duration<double>(seconds));
+        //read the counters before stopping so the totals match the elapsed time
+        uint64_t accepted = 0, requests = 0, minShare = UINT64_MAX, maxShare = 0;
+        for(auto& loop : loops)
+        {
+            accepted += loop->acceptedCount();
+            requests += loop->requestCount();
+            minShare = min(minShare, loop->acceptedCount());
+            maxShare = max(maxShare, loop->acceptedCount());
+        }
+        double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        running.store(false);
+        for(auto& generator : generators)
+        {
+            generator.join();
+        }
+        loops.clear();
+
+        rows.push_back({threads, accepted / elapsed, requests / elapsed, minShare, maxShare});
+    }
+
+    cout << "\nloops | accepted conn/s | requests/s | accepts per loop (min..max)" << endl;
+    for(const Row& row : rows)
+    {
+        printf("%5d | %15.0f | %10.0f | %llu..%llu\n", row.threads, row.connectionsPerSec,
+               row.requestsPerSec, (unsigned long long)row.minShare, (unsigned long long)row.maxShare);
+    }
+}
+
+/* ---------- FRAMING BENCHMARK -------------------------------------------------------*
+    server --bench-framing
+
+    One event loop echoes frames to a single loopback connection. A sender thread
+    streams 64 B, 4 KB and 1 MB frames while a receiver thread reads the echoes back;
+    the clock stops when the last echo has arrived. Two client implementations:
+      copying  what the old text protocol cost per message: the message is copied
+               into a staging buffer and sent with its own send(); the receiver reads
+               into a 1500-byte buffer (cleared first, as before), appends it to an
+               accumulator and copies every payload out
+      codec    MessageCodec: frames are queued by reference and go out in one
+               sendmsg() per batch; echoes are parsed in place from the receive ring
+*------------------------------------------------------------------------------------*/
+
+int connectLoopback(int port)
+{
+    sockaddr_in server;
+    bzero((char*)&server, sizeof(server));
+    server.sin_family = AF_INET;
+    server.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    server.sin_port = htons(port);
+    int sd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if(connect(sd, (sockaddr*)&server, sizeof(server)) < 0)
+    {
+        close(sd);
+        return -1;
+    }
+    int one = 1;
+    setsockopt(sd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    return sd;
+}
+
+bool sendAll(int sd, const uint8_t* data, size_t size)
+{
+    while(size > 0)
+    {
+        ssize_t n = send(sd, data, size, MSG_NOSIGNAL);
+        if(n <= 0)
+            return false;
+        data += n;
+        size -= n;
+    }
+    return true;
+}
+
+void sendCopying(int sd, const vector<uint8_t>& payload, int messages)
+{
+    for(int i = 0; i < messages; i++)
+    {
+        vector<uint8_t> staging(FRAME_HEADER_SIZE + payload.size());
+        encodeFrameHeader(staging.data(), MessageType::TEXT, i, payload.size());
+        memcpy(staging.data() + FRAME_HEADER_SIZE, payload.data(), payload.size());
+        if(!sendAll(sd, staging.data(), staging.size()))
+            return;
+    }
+}
+
+uint64_t receiveCopying(int sd, int messages)
+{
+    char msg[1500];
+    vector<uint8_t> pending;
+    uint64_t checksum = 0;
+    for(int got = 0; got < messages;)
+    {
+        memset(&msg, 0, sizeof(msg));
+        ssize_t n = recv(sd, msg, sizeof(msg), 0);
+        if(n <= 0)
+            break;
+        pending.insert(pending.end(), msg, msg + n);
+        size_t offset = 0;
+        while(pending.size() - offset >= FRAME_HEADER_SIZE)
+        {
+            uint32_t length;
+            memcpy(&length, pending.data() + offset, 4);
+            length = ntohl(length);
+            if(pending.size() - offset < FRAME_HEADER_SIZE + length)
+                break;
+            const uint8_t* body = pending.data() + offset + FRAME_HEADER_SIZE;
+            vector<uint8_t> payload(body, body + length);
+            checksum += payload.empty() ? 0 : payload.back();
+            offset += FRAME_HEADER_SIZE + length;
+            got++;
+        }
+        pending.erase(pending.begin(), pending.begin() + offset);
+    }
+    return checksum;
+}
+
+void sendCodec(int sd, const vector<uint8_t>& payload, int messages)
+{
+    //about 256 KiB per sendmsg(), and at least one frame
+    const int batch = max<int>(1, min<int>(IOV_MAX / 2, (256 * 1024) / (FRAME_HEADER_SIZE + payload.size())));
+    MessageCodec codec;
+    for(int i = 0; i < messages;)
+    {
+        for(int end = min(messages, i + batch); i < end; i++)
+        {
+            codec.enqueue(MessageType::TEXT, i, payload);
+        }
+        if(!codec.flush(sd))
+            return;
+    }
+}
+
+uint64_t receiveCodec(int sd, int messages)
+{
+    MessageCodec codec;
+    uint64_t checksum = 0;
+    for(int got = 0; got < messages; got++)
+    {
+        optional<Frame> frame = codec.receiveFrame(sd);
+        if(!frame)
+            break;
+        checksum += frame->payload.empty() ? 0 : frame->payload.back();
+    }
+    return checksum;
+}
+
+void runFramingBenchmark()
+{
+    int port = 0;
+    vector<unique_ptr<EventLoop>> loops;
+    if(!openEventLoops(port, 1, SOMAXCONN, loops))
+    {
+        cerr << "Error opening the echo server" << endl;
+        return;
+    }
+
+    struct Row
+    {
+        size_t payloadSize;
+        int messages;
+        double copyingPerSec;
+        double codecPerSec;
+    };
+    vector<Row> rows;
+    uint64_t checksum = 0;
+
+    for(size_t payloadSize : {size_t(64), size_t(4096), size_t(1) << 20})
+    {
+        //about 256 MiB of payload per run, capped at 1M messages
+        int messages = (int)min<size_t>(1000000, (256u << 20) / payloadSize);
+        vector<uint8_t> payload(payloadSize, 'x');
+        double perSec[2];
+        for(int useCodec = 0; useCodec < 2; useCodec++)
+        {
+            int sd = connectLoopback(port);
+            if(sd < 0)
+            {
+                cerr << "Error connecting to the echo server" << endl;
+                return;
+            }
+            auto start = chrono::steady_clock::now();
+            thread receiver([&]() {
+                checksum += useCodec ? receiveCodec(sd, messages) : receiveCopying(sd, messages);
+            });
+            if(useCodec)
+                sendCodec(sd, payload, messages);
+            else
+                sendCopying(sd, payload, messages);
+            receiver.join();
+            perSec[useCodec] = messages / chrono::duration<double>(chrono::steady_clock::now() - start).count();
+            close(sd);
+        }
+        rows.push_back({payloadSize, messages, perSec[0], perSec[1]});
+    }
+
+    cout << "\npayload | messages | copying msg/s | codec msg/s | codec MB/s | speedup" << endl;
+    for(const Row& row : rows)
+    {
+        printf("%7zu | %8d | %13.0f | %11.0f | %10.1f | %6.2fx\n", row.payloadSize, row.messages,
+               row.copyingPerSec, row.codecPerSec, row.codecPerSec * row.payloadSize / 1e6,
+               row.codecPerSec / row.copyingPerSec);
+    }
+    cout << "(checksum " << checksum << ")" << endl;
+}
+
+/* ---------- FILE TRANSFER BENCHMARK -------------------------------------------------*
+    server --bench-files [--size MB]
+
+    Writes a MB-sized file (default 512) into a temporary directory, serves that
+    directory from one event loop, and downloads the file over loopback with
+    fetchFile() (recv straight into a fallocate'd, mmap'd destination) once per way of
+    sending it:
+      read/send  pread() into a 64 KiB buffer, then send() it: two copies per byte
+      sendfile   sendfile(2) from the page cache into the socket
+      splice     splice(2) file -> pipe -> socket (the path used for non-regular files)
+    CPU % is the thread's CPU time over the wall time of the transfer: "server" is the
+    event-loop thread, "client" the receiving thread. On loopback the receiver's TCP
+    work is partly charged to the sender, so compare rows, not the absolute numbers.
+*------------------------------------------------------------------------------------*/
+
+double threadCpuSeconds()
+{
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+//true if both files hold the same bytes
+bool sameContents(const string& a, const string& b)
+{
+    int fa = open(a.c_str(), O_RDONLY | O_CLOEXEC);
+    int fb = open(b.c_str(), O_RDONLY | O_CLOEXEC);
+    struct stat sa, sb;
+    bool same = fa >= 0 && fb >= 0 && fstat(fa, &sa) == 0 && fstat(fb, &sb) == 0 && sa.st_size == sb.st_size;
+    if(same && sa.st_size > 0)
+    {
+        void* ma = mmap(NULL, sa.st_size, PROT_READ, MAP_PRIVATE, fa, 0);
+        void* mb = mmap(NULL, sb.st_size, PROT_READ, MAP_PRIVATE, fb, 0);
+        same = ma != MAP_FAILED && mb != MAP_FAILED && memcmp(ma, mb, sa.st_size) == 0;
+        if(ma != MAP_FAILED)
+            munmap(ma, sa.st_size);
+        if(mb != MAP_FAILED)
+            munmap(mb, sb.st_size);
+    }
+    if(fa >= 0)
+        close(fa);
+    if(fb >= 0)
+        close(fb);
+    return same;
+}
+
+void runFileBenchmark(size_t sizeMB)
+{
+    char dirTemplate[] = "/tmp/file-bench-XXXXXX";
+    if(mkdtemp(dirTemplate) == NULL)
+    {
+        cerr << "Cannot create a temporary directory" << endl;
+        return;
+    }
+    string dir = dirTemplate;
+    string source = dir + "/source.bin";
+    string copy = dir + "/copy.bin";
+
+    //non-repeating content, so a misplaced block would not go unnoticed
+    {
+        ofstream out(source, ios::binary);
+        vector<uint64_t> block(1 << 17);
+        uint64_t x = 0x9E3779B97F4A7C15ull;
+        for(size_t written = 0; written < sizeMB << 20; written += block.size() * sizeof(uint64_t))
+        {
+            for(uint64_t& word : block)
+            {
+                x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+                word = x;
+            }
+            out.write((const char*)block.data(), block.size() * sizeof(uint64_t));
+        }
+    }
+    int rootFd = open(dir.c_str(), O_PATH | O_DIRECTORY | O_CLOEXEC);
+
+    struct Row
+    {
+        const char* name;
+        double gbPerSec;
+        double serverCpu;
+        double clientCpu;
+        bool verified;
+    };
+    vector<Row> rows;
+    const pair<const char*, FileSender::Method> methods[] = {
+        {"read/send", FileSender::Method::COPY},
+        {"sendfile ", FileSender::Method::AUTO},
+        {"splice   ", FileSender::Method::SPLICE},
+    };
+    for(const auto& [name, method] : methods)
+    {
+        int port = 0;
+        vector<unique_ptr<EventLoop>> loops;
+        if(!openEventLoops(port, 1, SOMAXCONN, loops, rootFd, method))
+        {
+            cerr << "Error opening the file server" << endl;
+            break;
+        }
+        int sd = connectLoopback(port);
+        if(sd < 0)
+        {
+            cerr << "Error connecting to the file server" << endl;
+            break;
+        }
+        unlink(copy.c_str());
+        MessageCodec codec;
+        FileReceipt receipt;
+        string error;
+
+        double serverStart = loops[0]->cpuSeconds();
+        double clientStart = threadCpuSeconds();
+        auto start = chrono::steady_clock::now();
+        bool ok = fetchFile(sd, codec, 0, "source.bin", copy, 0, 0, receipt, error);
+        double wall = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        double clientCpu = threadCpuSeconds() - clientStart;
+        double serverCpu = loops[0]->cpuSeconds() - serverStart;
+        close(sd);
+        if(!ok)
+        {
+            cerr << name << ": " << error << endl;
+            continue;
+        }
+        rows.push_back({name, receipt.received / wall / 1e9, 100 * serverCpu / wall,
+                        100 * clientCpu / wall, sameContents(source, copy)});
+    }
+
+    cout << "\n" << sizeMB << " MiB file over loopback, received into an mmap'd destination" << endl;
+    cout << "method    |  GB/s | server CPU % | client CPU % | contents" << endl;
+    for(const Row& row : rows)
+    {
+        printf("%s | %5.2f | %12.0f | %12.0f | %s\n", row.name, row.gbPerSec, row.serverCpu,
+               row.clientCpu, row.verified ? "identical" : "MISMATCH");
+    }
+
+    close(rootFd);
+    unlink(copy.c_str());
+    unlink(source.c_str());
+    rmdir(dir.c_str());
+}
+
+int main(int argc, char *argv[])
+{
+    //  server port                                         interactive session with one client
+    //  server --threads N [--backlog B] [--files DIR] port   N SO_REUSEPORT event loops
+    //  server --bench [--backlog B] [--seconds S]          loopback load test at 1/2/4/8 loops
+    //  server --bench-framing                              copying vs MessageCodec messages/sec
+    //  server --bench-files [--size MB]                    read/send vs sendfile vs splice
+    int port = -1;
+    int threads = 0;
+    int backlog = SOMAXCONN;
+    double seconds = 2.0;
+    bool bench = false;
+    bool benchFraming = false;
+    bool benchFiles = false;
+    size_t sizeMB = 512;
+    string filesDir;
+    for(int i = 1; i < argc; i++)
+    {
+        string arg = argv[i];
+        if(arg == "--threads" && i + 1 < argc)
+            threads = atoi(argv[++i]);
+        else if(arg == "--backlog" && i + 1 < argc)
+            backlog = atoi(argv[++i]);
+        else if(arg == "--seconds" && i + 1 < argc)
+            seconds = atof(argv[++i]);
+        else if(arg == "--bench")
+            bench = true;
+        else if(arg == "--bench-framing")
+            benchFraming = true;
+        else if(arg == "--bench-files")
+            benchFiles = true;
+        else if(arg == "--size" && i + 1 < argc)
+            sizeMB = max(1, atoi(argv[++i]));
+        else if(arg == "--files" && i + 1 < argc)
+            filesDir = argv[++i];
+        else if(port < 0 && arg[0] != '-')
+            port = atoi(argv[i]);
+        else
+            port = -2;
+    }
+    if(benchFraming && port == -1)
+    {
+        runFramingBenchmark();
+    }
+    else if(benchFiles && port == -1)
+    {
+        runFileBenchmark(sizeMB);
+    }
+    else if(bench && port == -1)
+    {
+        runLoadBenchmark(backlog, seconds);
+    }
+    else if(port >= 0 && threads > 0)
+    {
+        runThreadedServer(port, threads, backlog, filesDir);
+    }
+    else if(port >= 0 && argc == 2)
+    {
+        runInteractiveServer(port);
+    }
+    else
+    {
+        cerr << "Usage: port | --threads N [--backlog B] [--files DIR] port | --bench [--backlog B] [--seconds S]"
+                " | --bench-framing | --bench-files [--size MB]" << endl;
+        exit(0);
+    }
+    return 0;
+}